@@ -0,0 +1,553 @@
+#include "stdlib.h"
+#include "string.h"
+#include "limits.h"
+#include "range.h"
+
+// Iterations of a while loop before unstable bounds are widened to the
+// int limits, and descending iterations run afterwards to win back the
+// precision widening lost (e.g. the upper bound of `i` in `i < 100`).
+#define WIDEN_AFTER 3
+#define NARROW_STEPS 2
+
+// Bounds are kept in 64 bits so int arithmetic on them cannot overflow.
+// An interval with lo > hi is empty: no value can reach that point.
+typedef struct{
+    long long lo;
+    long long hi;
+}Interval;
+
+typedef struct{
+    Interval* ranges;   // one per variable
+    bool reachable;
+}State;
+
+typedef struct{
+    Token* names;
+    int count;
+    int capacity;
+}Analyzer;
+
+//============ INTERVALS =========================
+
+static Interval interval(long long lo, long long hi){
+    Interval result;
+    result.lo = lo;
+    result.hi = hi;
+    return result;
+}
+
+static Interval anyInt(){
+    return interval(INT_MIN,INT_MAX);
+}
+
+static bool isEmpty(Interval a){
+    return a.lo > a.hi;
+}
+
+static bool fitsInt(Interval a){
+    return a.lo >= INT_MIN && a.hi <= INT_MAX;
+}
+
+// Values that survive a checked operation always fit in an int.
+static Interval clampInt(Interval a){
+    if(a.lo < INT_MIN)a.lo = INT_MIN;
+    if(a.hi > INT_MAX)a.hi = INT_MAX;
+    return a;
+}
+
+static bool contains(Interval a, long long value){
+    return a.lo <= value && value <= a.hi;
+}
+
+static Interval joinInterval(Interval a, Interval b){
+    if(isEmpty(a))return b;
+    if(isEmpty(b))return a;
+    return interval(a.lo < b.lo ? a.lo : b.lo, a.hi > b.hi ? a.hi : b.hi);
+}
+
+static Interval truthValue(bool canBeFalse, bool canBeTrue){
+    return interval(canBeFalse ? 0 : 1, canBeTrue ? 1 : 0);
+}
+
+//============ STATES ============================
+
+static State newState(Analyzer* a){
+    State s;
+    s.ranges = malloc(sizeof(Interval) * (a->count > 0 ? a->count : 1));
+    for(int i = 0;i<a->count;i++)s.ranges[i] = anyInt();
+    s.reachable = true;
+    return s;
+}
+
+static State copyState(Analyzer* a, State* from){
+    State s = newState(a);
+    memcpy(s.ranges,from->ranges,sizeof(Interval) * a->count);
+    s.reachable = from->reachable;
+    return s;
+}
+
+static void assignState(Analyzer* a, State* to, State* from){
+    memcpy(to->ranges,from->ranges,sizeof(Interval) * a->count);
+    to->reachable = from->reachable;
+}
+
+static void freeState(State* s){
+    free(s->ranges);
+}
+
+static void joinInto(Analyzer* a, State* to, State* from){
+    if(!from->reachable)return;
+    if(!to->reachable){
+        assignState(a,to,from);
+        return;
+    }
+    for(int i = 0;i<a->count;i++)to->ranges[i] = joinInterval(to->ranges[i],from->ranges[i]);
+}
+
+// Bounds of `next` that moved past those of `previous` jump to the int
+// limits, the others stay where `previous` had them.
+static void widenInto(Analyzer* a, State* next, State* previous){
+    if(!previous->reachable || !next->reachable)return;
+    for(int i = 0;i<a->count;i++){
+        next->ranges[i].lo = next->ranges[i].lo < previous->ranges[i].lo ? INT_MIN : previous->ranges[i].lo;
+        next->ranges[i].hi = next->ranges[i].hi > previous->ranges[i].hi ? INT_MAX : previous->ranges[i].hi;
+    }
+}
+
+static bool sameState(Analyzer* a, State* x, State* y){
+    if(x->reachable != y->reachable)return false;
+    if(!x->reachable)return true;
+    for(int i = 0;i<a->count;i++){
+        if(x->ranges[i].lo != y->ranges[i].lo || x->ranges[i].hi != y->ranges[i].hi)return false;
+    }
+    return true;
+}
+
+//============ VARIABLES =========================
+
+static int findName(Analyzer* a, Token* name){
+    for(int i = 0;i<a->count;i++){
+        if(a->names[i].length == name->length && memcmp(a->names[i].start,name->start,name->length) == 0)return i;
+    }
+    return -1;
+}
+
+static void addName(Analyzer* a, Token* name){
+    if(findName(a,name) >= 0)return;
+    if(a->count >= a->capacity){
+        a->capacity = (a->capacity < 8) ? 8 : a->capacity * 2;
+        a->names = realloc(a->names, sizeof(Token) * a->capacity);
+    }
+    a->names[a->count++] = *name;
+}
+
+// Collects every variable name and provisionally marks every operation
+// safe. Evaluation puts the check back wherever a reachable state may
+// overflow, so operations in unreachable code stay unchecked.
+static void prepareExpr(Analyzer* a, Expr* expr){
+    switch(expr->type){
+        case EXPR_BINARY:
+            expr->as.binary.needsCheck = false;
+            prepareExpr(a,expr->as.binary.left);
+            prepareExpr(a,expr->as.binary.right);
+            break;
+        case EXPR_UNARY:
+            expr->as.unary.needsCheck = false;
+            prepareExpr(a,expr->as.unary.right);
+            break;
+        case EXPR_GROUPING:
+            prepareExpr(a,expr->as.grouping.expression);
+            break;
+        case EXPR_VARIABLE:
+            addName(a,&expr->as.variable.name);
+            break;
+        case EXPR_ASSIGN:
+            addName(a,&expr->as.assign.name);
+            prepareExpr(a,expr->as.assign.value);
+            break;
+        case EXPR_LITERAL:
+            break;
+    }
+}
+
+static void prepareStmt(Analyzer* a, Stmt* stmt){
+    if(stmt == NULL)return;
+    switch(stmt->type){
+        case STMT_EXPRESSION: prepareExpr(a,stmt->as.expression.expression); break;
+        case STMT_PRINT:      prepareExpr(a,stmt->as.print.expression); break;
+        case STMT_VAR_DECLARATION:
+            addName(a,&stmt->as.var.name);
+            if(stmt->as.var.initializer != NULL)prepareExpr(a,stmt->as.var.initializer);
+            break;
+        case STMT_IF:
+            prepareExpr(a,stmt->as.ifStmt.condition);
+            prepareStmt(a,stmt->as.ifStmt.thenBranch);
+            prepareStmt(a,stmt->as.ifStmt.elseBranch);
+            break;
+        case STMT_WHILE:
+            prepareExpr(a,stmt->as.whileStmt.condition);
+            prepareStmt(a,stmt->as.whileStmt.body);
+            break;
+        case STMT_BLOCK:
+            break;
+    }
+}
+
+//============ EXPRESSIONS =======================
+
+static Interval evaluate(Analyzer* a, State* s, Expr* expr);
+
+static Interval evaluateArithmetic(BinaryExpr* binary, Interval l, Interval r){
+    Interval result;
+    bool safe;
+    switch(binary->op.type){
+        case TOKEN_PLUS:
+            result = interval(l.lo + r.lo,l.hi + r.hi);
+            safe = fitsInt(result);
+            break;
+        case TOKEN_MINUS:
+            result = interval(l.lo - r.hi,l.hi - r.lo);
+            safe = fitsInt(result);
+            break;
+        case TOKEN_STAR:{
+            long long corners[4] = {l.lo * r.lo, l.lo * r.hi, l.hi * r.lo, l.hi * r.hi};
+            result = interval(corners[0],corners[0]);
+            for(int i = 1;i<4;i++){
+                if(corners[i] < result.lo)result.lo = corners[i];
+                if(corners[i] > result.hi)result.hi = corners[i];
+            }
+            safe = fitsInt(result);
+            break;
+        }
+        default:{
+            // Division: look at the negative and positive divisors separately,
+            // truncating division is monotonic on each side of zero.
+            safe = !contains(r,0) && !(contains(l,INT_MIN) && contains(r,-1));
+            result = interval(1,0);
+            Interval parts[2] = {interval(r.lo,r.hi < -1 ? r.hi : -1), interval(r.lo > 1 ? r.lo : 1,r.hi)};
+            for(int p = 0;p<2;p++){
+                if(isEmpty(parts[p]))continue;
+                long long corners[4] = {l.lo / parts[p].lo, l.lo / parts[p].hi, l.hi / parts[p].lo, l.hi / parts[p].hi};
+                for(int i = 0;i<4;i++)result = joinInterval(result,interval(corners[i],corners[i]));
+            }
+            break;
+        }
+    }
+    if(!safe)binary->needsCheck = true;
+    return clampInt(result);
+}
+
+// Range of a comparison result: [1,1] or [0,0] when it is already decided.
+static Interval evaluateComparison(token_type op, Interval l, Interval r){
+    bool lessPossible = l.lo < r.hi, lessCertain = l.hi < r.lo;
+    bool greaterPossible = l.hi > r.lo, greaterCertain = l.lo > r.hi;
+    bool equalPossible = l.lo <= r.hi && r.lo <= l.hi;
+    bool equalCertain = l.lo == l.hi && r.lo == r.hi && l.lo == r.lo;
+    switch(op){
+        case TOKEN_SMALLER:       return truthValue(!lessCertain,lessPossible);
+        case TOKEN_SMALLER_EQUAL: return truthValue(greaterPossible,!greaterCertain);
+        case TOKEN_GREATER:       return truthValue(!greaterCertain,greaterPossible);
+        case TOKEN_GREATER_EQUAL: return truthValue(lessPossible,!lessCertain);
+        case TOKEN_EQUAL_EQUAL:   return truthValue(!equalCertain,equalPossible);
+        case TOKEN_BANG_EQUAL:    return truthValue(equalPossible,!equalCertain);
+        default:                  return truthValue(true,true);
+    }
+}
+
+static Interval evaluate(Analyzer* a, State* s, Expr* expr){
+    switch(expr->type){
+        case EXPR_LITERAL:
+            return interval(expr->as.literal.value,expr->as.literal.value);
+        case EXPR_GROUPING:
+            return evaluate(a,s,expr->as.grouping.expression);
+        case EXPR_VARIABLE:
+            return s->ranges[findName(a,&expr->as.variable.name)];
+        case EXPR_ASSIGN:{
+            Interval value = evaluate(a,s,expr->as.assign.value);
+            if(!isEmpty(value))s->ranges[findName(a,&expr->as.assign.name)] = value;
+            return value;
+        }
+        case EXPR_BINARY:{
+            BinaryExpr* binary = &expr->as.binary;
+            Interval l = evaluate(a,s,binary->left);
+            if(isEmpty(l))return l;
+            Interval r = evaluate(a,s,binary->right);
+            if(isEmpty(r))return r;
+            switch(binary->op.type){
+                case TOKEN_PLUS:
+                case TOKEN_MINUS:
+                case TOKEN_STAR:
+                case TOKEN_SLASH:
+                    return evaluateArithmetic(binary,l,r);
+                default:
+                    return evaluateComparison(binary->op.type,l,r);
+            }
+        }
+        case EXPR_UNARY:{
+            UnaryExpr* unary = &expr->as.unary;
+            Interval r = evaluate(a,s,unary->right);
+            if(isEmpty(r))return r;
+            switch(unary->op.type){
+                case TOKEN_MINUS:
+                    if(contains(r,INT_MIN))unary->needsCheck = true;
+                    return clampInt(interval(-r.hi,-r.lo));
+                case TOKEN_BANG:
+                    return truthValue(r.lo != 0 || r.hi != 0,contains(r,0));
+                default:
+                    return r;
+            }
+        }
+    }
+    return anyInt();
+}
+
+//============ CONDITIONS ========================
+
+static bool isPure(Expr* expr){
+    switch(expr->type){
+        case EXPR_ASSIGN:   return false;
+        case EXPR_BINARY:   return isPure(expr->as.binary.left) && isPure(expr->as.binary.right);
+        case EXPR_UNARY:    return isPure(expr->as.unary.right);
+        case EXPR_GROUPING: return isPure(expr->as.grouping.expression);
+        default:            return true;
+    }
+}
+
+static token_type negateComparison(token_type op){
+    switch(op){
+        case TOKEN_SMALLER:       return TOKEN_GREATER_EQUAL;
+        case TOKEN_SMALLER_EQUAL: return TOKEN_GREATER;
+        case TOKEN_GREATER:       return TOKEN_SMALLER_EQUAL;
+        case TOKEN_GREATER_EQUAL: return TOKEN_SMALLER;
+        case TOKEN_EQUAL_EQUAL:   return TOKEN_BANG_EQUAL;
+        default:                  return TOKEN_EQUAL_EQUAL;
+    }
+}
+
+// `a op b` is the same test as `b mirror(op) a`.
+static token_type mirrorComparison(token_type op){
+    switch(op){
+        case TOKEN_SMALLER:       return TOKEN_GREATER;
+        case TOKEN_SMALLER_EQUAL: return TOKEN_GREATER_EQUAL;
+        case TOKEN_GREATER:       return TOKEN_SMALLER;
+        case TOKEN_GREATER_EQUAL: return TOKEN_SMALLER_EQUAL;
+        default:                  return op;
+    }
+}
+
+static bool isComparison(token_type op){
+    return op == TOKEN_SMALLER || op == TOKEN_SMALLER_EQUAL || op == TOKEN_GREATER ||
+           op == TOKEN_GREATER_EQUAL || op == TOKEN_EQUAL_EQUAL || op == TOKEN_BANG_EQUAL;
+}
+
+// Narrows variable `index` to the values for which `var op r` holds.
+static void narrowVariable(State* s, int index, token_type op, Interval r){
+    Interval* x = &s->ranges[index];
+    switch(op){
+        case TOKEN_SMALLER:       if(r.hi - 1 < x->hi)x->hi = r.hi - 1; break;
+        case TOKEN_SMALLER_EQUAL: if(r.hi < x->hi)x->hi = r.hi; break;
+        case TOKEN_GREATER:       if(r.lo + 1 > x->lo)x->lo = r.lo + 1; break;
+        case TOKEN_GREATER_EQUAL: if(r.lo > x->lo)x->lo = r.lo; break;
+        case TOKEN_EQUAL_EQUAL:
+            if(r.lo > x->lo)x->lo = r.lo;
+            if(r.hi < x->hi)x->hi = r.hi;
+            break;
+        case TOKEN_BANG_EQUAL:
+            if(r.lo != r.hi)break;
+            if(x->lo == r.lo)x->lo++;
+            if(x->hi == r.lo)x->hi--;
+            break;
+        default:
+            break;
+    }
+    if(isEmpty(*x))s->reachable = false;
+}
+
+// Restricts s to the states in which cond evaluated to `truth`.
+// `value` is the range cond itself evaluated to.
+static void refine(Analyzer* a, State* s, Expr* cond, bool truth, Interval value){
+    if(!s->reachable)return;
+    if(truth ? (value.lo == 0 && value.hi == 0) : !contains(value,0)){
+        s->reachable = false;
+        return;
+    }
+    while(cond->type == EXPR_GROUPING)cond = cond->as.grouping.expression;
+
+    if(cond->type == EXPR_VARIABLE){
+        int index = findName(a,&cond->as.variable.name);
+        Interval zero = interval(0,0);
+        narrowVariable(s,index,truth ? TOKEN_BANG_EQUAL : TOKEN_EQUAL_EQUAL,zero);
+        return;
+    }
+    if(cond->type == EXPR_UNARY && cond->as.unary.op.type == TOKEN_BANG){
+        refine(a,s,cond->as.unary.right,!truth,truthValue(true,true));
+        return;
+    }
+    if(cond->type != EXPR_BINARY || !isComparison(cond->as.binary.op.type) || !isPure(cond))return;
+
+    BinaryExpr* binary = &cond->as.binary;
+    token_type op = truth ? binary->op.type : negateComparison(binary->op.type);
+    Expr* left = binary->left;
+    Expr* right = binary->right;
+    while(left->type == EXPR_GROUPING)left = left->as.grouping.expression;
+    while(right->type == EXPR_GROUPING)right = right->as.grouping.expression;
+    Interval l = evaluate(a,s,left);
+    Interval r = evaluate(a,s,right);
+    if(left->type == EXPR_VARIABLE)narrowVariable(s,findName(a,&left->as.variable.name),op,r);
+    if(right->type == EXPR_VARIABLE && s->reachable)narrowVariable(s,findName(a,&right->as.variable.name),mirrorComparison(op),l);
+}
+
+//============ STATEMENTS ========================
+
+static void execute(Analyzer* a, State* s, Stmt* stmt);
+
+// One trip around a loop: evaluates the guard on head, runs the body on
+// the states that enter it and joins the result with the loop entry.
+// Leaves the states that leave the loop in exit.
+static void loopStep(Analyzer* a, WhileStmt* loop, State* entry, State* head, State* next, State* exit){
+    assignState(a,exit,head);
+    Interval value = evaluate(a,exit,loop->condition);
+    if(isEmpty(value))exit->reachable = false;
+    State body = copyState(a,exit);
+    refine(a,&body,loop->condition,true,value);
+    refine(a,exit,loop->condition,false,value);
+    execute(a,&body,loop->body);
+    assignState(a,next,entry);
+    joinInto(a,next,&body);
+    freeState(&body);
+}
+
+static void executeWhile(Analyzer* a, State* s, WhileStmt* loop){
+    State entry = copyState(a,s);
+    State head = copyState(a,s);
+    State next = copyState(a,s);
+    State exit = copyState(a,s);
+
+    for(int iteration = 0;;iteration++){
+        loopStep(a,loop,&entry,&head,&next,&exit);
+        if(iteration >= WIDEN_AFTER)widenInto(a,&next,&head);
+        else joinInto(a,&next,&head);
+        if(sameState(a,&next,&head))break;
+        assignState(a,&head,&next);
+    }
+    // head now covers every state at the guard; tighten it again.
+    for(int i = 0;i<NARROW_STEPS;i++){
+        loopStep(a,loop,&entry,&head,&next,&exit);
+        if(sameState(a,&next,&head))break;
+        assignState(a,&head,&next);
+    }
+    assignState(a,s,&exit);
+
+    freeState(&entry);
+    freeState(&head);
+    freeState(&next);
+    freeState(&exit);
+}
+
+static void execute(Analyzer* a, State* s, Stmt* stmt){
+    if(!s->reachable)return;
+    switch(stmt->type){
+        case STMT_EXPRESSION:
+            if(isEmpty(evaluate(a,s,stmt->as.expression.expression)))s->reachable = false;
+            break;
+        case STMT_PRINT:
+            if(isEmpty(evaluate(a,s,stmt->as.print.expression)))s->reachable = false;
+            break;
+        case STMT_VAR_DECLARATION:{
+            Interval value = interval(0,0);
+            if(stmt->as.var.initializer != NULL)value = evaluate(a,s,stmt->as.var.initializer);
+            if(isEmpty(value))s->reachable = false;
+            else s->ranges[findName(a,&stmt->as.var.name)] = value;
+            break;
+        }
+        case STMT_IF:{
+            IfStmt* ifStmt = &stmt->as.ifStmt;
+            Interval value = evaluate(a,s,ifStmt->condition);
+            if(isEmpty(value)){
+                s->reachable = false;
+                break;
+            }
+            State thenState = copyState(a,s);
+            refine(a,&thenState,ifStmt->condition,true,value);
+            execute(a,&thenState,ifStmt->thenBranch);
+            refine(a,s,ifStmt->condition,false,value);
+            if(ifStmt->elseBranch != NULL)execute(a,s,ifStmt->elseBranch);
+            joinInto(a,s,&thenState);
+            freeState(&thenState);
+            break;
+        }
+        case STMT_WHILE:
+            executeWhile(a,s,&stmt->as.whileStmt);
+            break;
+        case STMT_BLOCK:
+            break;
+    }
+}
+
+//============ STATISTICS ========================
+
+static void countExpr(Expr* expr, RangeStats* stats){
+    switch(expr->type){
+        case EXPR_BINARY:{
+            token_type op = expr->as.binary.op.type;
+            if(op == TOKEN_PLUS || op == TOKEN_MINUS || op == TOKEN_STAR || op == TOKEN_SLASH){
+                stats->operations++;
+                if(!expr->as.binary.needsCheck)stats->proven++;
+            }
+            countExpr(expr->as.binary.left,stats);
+            countExpr(expr->as.binary.right,stats);
+            break;
+        }
+        case EXPR_UNARY:
+            if(expr->as.unary.op.type == TOKEN_MINUS){
+                stats->operations++;
+                if(!expr->as.unary.needsCheck)stats->proven++;
+            }
+            countExpr(expr->as.unary.right,stats);
+            break;
+        case EXPR_GROUPING: countExpr(expr->as.grouping.expression,stats); break;
+        case EXPR_ASSIGN:   countExpr(expr->as.assign.value,stats); break;
+        default: break;
+    }
+}
+
+static void countStmt(Stmt* stmt, RangeStats* stats){
+    if(stmt == NULL)return;
+    switch(stmt->type){
+        case STMT_EXPRESSION: countExpr(stmt->as.expression.expression,stats); break;
+        case STMT_PRINT:      countExpr(stmt->as.print.expression,stats); break;
+        case STMT_VAR_DECLARATION:
+            if(stmt->as.var.initializer != NULL)countExpr(stmt->as.var.initializer,stats);
+            break;
+        case STMT_IF:
+            countExpr(stmt->as.ifStmt.condition,stats);
+            countStmt(stmt->as.ifStmt.thenBranch,stats);
+            countStmt(stmt->as.ifStmt.elseBranch,stats);
+            break;
+        case STMT_WHILE:
+            countExpr(stmt->as.whileStmt.condition,stats);
+            countStmt(stmt->as.whileStmt.body,stats);
+            break;
+        case STMT_BLOCK:
+            break;
+    }
+}
+
+//============ PUBLIC INTERFACE ==================
+
+RangeStats analyze_ranges(Stmt** statements, int count){
+    Analyzer a;
+    a.names = NULL;
+    a.count = 0;
+    a.capacity = 0;
+    for(int i = 0;i<count;i++)prepareStmt(&a,statements[i]);
+
+    State s = newState(&a);
+    for(int i = 0;i<count;i++)execute(&a,&s,statements[i]);
+    freeState(&s);
+    free(a.names);
+
+    RangeStats stats = {0, 0};
+    for(int i = 0;i<count;i++)countStmt(statements[i],&stats);
+    return stats;
+}
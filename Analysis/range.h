@@ -0,0 +1,17 @@
+#ifndef RANGE_HEADER_H
+#define RANGE_HEADER_H
+#include "../Parsers/RecursiveDescentParser/AST.h"
+
+typedef struct{
+    int operations;     // arithmetic operations that could need a check
+    int proven;         // of those, how many were proven safe
+}RangeStats;
+
+// Interval analysis over the whole program. Tracks the range of every
+// variable through declarations, assignments, if conditions and while
+// guards, and clears needsCheck on each +, -, *, / and unary minus that
+// can never overflow or divide by zero. Variables the program does not
+// declare (e.g. bound by a host) are assumed to hold any int.
+RangeStats analyze_ranges(Stmt** statements, int count);
+
+#endif
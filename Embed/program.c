@@ -0,0 +1,135 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "program.h"
+#include "../Parsers/RecursiveDescentParser/RDparser.h"
+#include "../Analysis/range.h"
+#include "../VM/compiler.h"
+#include "../VM/fusion.h"
+#include "../VM/vm.h"
+
+struct Program{
+    char* source;       // slot names point into it
+    Chunk chunk;
+    VM vm;
+    Output stdoutSink;
+    int** bindings;     // host memory of every slot, NULL when unbound
+    int* bound;         // slots with a binding, in binding order
+    int boundCount;
+    bool* declared;     // slots the script declares itself
+    int unbound;        // host variables still waiting for a binding
+};
+
+//============ HELPER FUNCTIONS ==================
+
+static void markDeclared(Program* program, Stmt* stmt){
+    if(stmt == NULL)return;
+    switch(stmt->type){
+        case STMT_VAR_DECLARATION:{
+            Token* name = &stmt->as.var.name;
+            int slot = chunk_find_slot(&program->chunk,name->start,name->length);
+            if(slot >= 0)program->declared[slot] = true;
+            break;
+        }
+        case STMT_IF:
+            markDeclared(program,stmt->as.ifStmt.thenBranch);
+            markDeclared(program,stmt->as.ifStmt.elseBranch);
+            break;
+        case STMT_WHILE:
+            markDeclared(program,stmt->as.whileStmt.body);
+            break;
+        default:
+            break;
+    }
+}
+
+//============ PUBLIC INTERFACE ==================
+
+Program* program_compile(const char* source){
+    Program* program = (Program*)malloc(sizeof(Program));
+    size_t length = strlen(source);
+    program->source = (char*)malloc(length + 1);
+    memcpy(program->source,source,length + 1);
+
+    int count = 0;
+    Stmt** statements = parse(program->source,&count);
+    if(parser.hadError){
+        freeAst(statements,count);
+        free(program->source);
+        free(program);
+        return NULL;
+    }
+    analyze_ranges(statements,count);
+
+    chunk_init(&program->chunk);
+    program->chunk.freeVariables = true;
+    if(!compile(&program->chunk,statements,count)){
+        freeAst(statements,count);
+        chunk_free(&program->chunk);
+        free(program->source);
+        free(program);
+        return NULL;
+    }
+    fuse(&program->chunk,0);
+
+    int slots = program->chunk.slotCount;
+    program->bindings = (int**)calloc(slots > 0 ? slots : 1,sizeof(int*));
+    program->bound = (int*)malloc(sizeof(int) * (slots > 0 ? slots : 1));
+    program->boundCount = 0;
+    program->declared = (bool*)calloc(slots > 0 ? slots : 1,sizeof(bool));
+    for(int i = 0;i<count;i++)markDeclared(program,statements[i]);
+    program->unbound = 0;
+    for(int i = 0;i<slots;i++)if(!program->declared[i])program->unbound++;
+    freeAst(statements,count);
+
+    output_init_fd(&program->stdoutSink,1);
+    vm_init(&program->vm,&program->chunk,&program->stdoutSink);
+    vm_reserve(&program->vm);
+    return program;
+}
+
+bool program_bind(Program* program, const char* name, int* slot){
+    int index = chunk_find_slot(&program->chunk,name,(int)strlen(name));
+    if(index < 0)return false;
+    if(program->bindings[index] == NULL){
+        program->bound[program->boundCount++] = index;
+        if(!program->declared[index])program->unbound--;
+    }
+    program->bindings[index] = slot;
+    return true;
+}
+
+void program_set_output(Program* program, Output* out){
+    program->vm.out = out;
+}
+
+bool program_run(Program* program){
+    if(program->unbound > 0){
+        fprintf(stderr, "Runtime error: %d host variable%s not bound.\n",
+                program->unbound, program->unbound == 1 ? "" : "s");
+        return false;
+    }
+    int* slots = program->vm.slots;
+    for(int i = 0;i<program->boundCount;i++){
+        int index = program->bound[i];
+        slots[index] = *program->bindings[index];
+    }
+    bool ok = vm_run(&program->vm,0);
+    for(int i = 0;i<program->boundCount;i++){
+        int index = program->bound[i];
+        *program->bindings[index] = slots[index];
+    }
+    return ok;
+}
+
+void program_free(Program* program){
+    if(program == NULL)return;
+    output_free(&program->stdoutSink);
+    vm_free(&program->vm);
+    chunk_free(&program->chunk);
+    free(program->bindings);
+    free(program->bound);
+    free(program->declared);
+    free(program->source);
+    free(program);
+}
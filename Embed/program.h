@@ -0,0 +1,42 @@
+#ifndef PROGRAM_HEADER_H
+#define PROGRAM_HEADER_H
+#include "stdbool.h"
+#include "../Interpreter/output.h"
+
+// Compile-once/run-many interface for hosts that embed the language.
+//
+//     Program* program = program_compile("while (i < n) i = i + 1;");
+//     program_bind(program, "i", &hostI);
+//     program_bind(program, "n", &hostN);
+//     for (...) program_run(program);
+//
+// A variable the script uses without ever declaring it is a host variable
+// and must be bound before the program runs. Using a variable before the
+// script's own declaration of it is a compile error, so no script variable
+// carries a value from one run to the next. Bound variables are read from
+// host memory when a run starts and written back when it ends. Running
+// never parses and never allocates.
+//
+// Compiling uses the parser's global state, so compile from one thread
+// at a time. Separate programs may then run concurrently.
+typedef struct Program Program;
+
+// Returns NULL (after reporting the errors on stderr) when the source does
+// not parse or compile.
+Program* program_compile(const char* source);
+
+// Binds the variable `name` to *slot. Returns false when the program has no
+// variable of that name. Binding a variable the script declares itself is
+// allowed; its declaration then overwrites the host value on every run.
+bool program_bind(Program* program, const char* name, int* slot);
+
+// Where print statements go. Defaults to a buffered sink on stdout.
+void program_set_output(Program* program, Output* out);
+
+// Runs the program once. Returns false on a runtime error or when a host
+// variable is still unbound.
+bool program_run(Program* program);
+
+void program_free(Program* program);
+
+#endif
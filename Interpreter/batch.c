@@ -0,0 +1,608 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "limits.h"
+#include "batch.h"
+#if defined(__AVX2__) || defined(__SSE2__)
+#include "immintrin.h"
+#endif
+
+// Values and masks are stored lane-wise (structure of arrays), padded to a
+// multiple of BATCH_WIDTH. A mask entry is -1 for an active lane, 0 otherwise.
+
+typedef struct{
+    Token name;
+    int* values;
+}LaneVariable;
+
+typedef struct{
+    int lanes;
+    int padded;
+    LaneVariable* variables;
+    int count;
+    int capacity;
+    int* alive;         // lanes that have not hit a runtime error
+    int** pool;         // scratch lane arrays, used as a stack
+    int poolTop;
+    int poolCapacity;
+    BatchOutput* prints;
+    bool* laneFailed;
+}Batch;
+
+// The lanes a statement or expression applies to: the mask plus the chunks
+// that still hold an active lane. Every loop walks the chunk list only, so
+// lanes that retired or left a loop stop costing anything once their whole
+// chunk is done. Mask and value entries outside the listed chunks are
+// never read.
+typedef struct{
+    int* bits;      // -1 for an active lane, 0 otherwise
+    int* chunks;    // offsets of the chunks with an active lane
+    int count;
+}Lanes;
+
+//============ CHUNK PRIMITIVES ==================
+// Each works on one chunk of BATCH_WIDTH lanes.
+
+#if defined(__AVX2__)
+#define LOAD8(p) _mm256_loadu_si256((const __m256i*)(p))
+#define STORE8(p,v) _mm256_storeu_si256((__m256i*)(p),(v))
+#elif defined(__SSE2__)
+#define LOAD4(p) _mm_loadu_si128((const __m128i*)(p))
+#define STORE4(p,v) _mm_storeu_si128((__m128i*)(p),(v))
+#endif
+
+static inline bool chunk_any(const int* m){
+#if defined(__AVX2__)
+    __m256i v = LOAD8(m);
+    return !_mm256_testz_si256(v,v);
+#elif defined(__SSE2__)
+    return _mm_movemask_epi8(_mm_or_si128(LOAD4(m),LOAD4(m + 4))) != 0;
+#else
+    for(int i = 0;i<BATCH_WIDTH;i++)if(m[i])return true;
+    return false;
+#endif
+}
+
+// d = a + b, ovf = -1 where the addition overflowed.
+static inline void chunk_add(const int* a, const int* b, int* d, int* ovf){
+#if defined(__AVX2__)
+    __m256i x = LOAD8(a), y = LOAD8(b), r = _mm256_add_epi32(x,y);
+    __m256i o = _mm256_and_si256(_mm256_xor_si256(x,r),_mm256_xor_si256(y,r));
+    STORE8(d,r);
+    STORE8(ovf,_mm256_srai_epi32(o,31));
+#elif defined(__SSE2__)
+    for(int h = 0;h<BATCH_WIDTH;h+=4){
+        __m128i x = LOAD4(a + h), y = LOAD4(b + h), r = _mm_add_epi32(x,y);
+        __m128i o = _mm_and_si128(_mm_xor_si128(x,r),_mm_xor_si128(y,r));
+        STORE4(d + h,r);
+        STORE4(ovf + h,_mm_srai_epi32(o,31));
+    }
+#else
+    for(int i = 0;i<BATCH_WIDTH;i++)ovf[i] = __builtin_add_overflow(a[i],b[i],&d[i]) ? -1 : 0;
+#endif
+}
+
+// d = a - b, ovf = -1 where the subtraction overflowed.
+static inline void chunk_sub(const int* a, const int* b, int* d, int* ovf){
+#if defined(__AVX2__)
+    __m256i x = LOAD8(a), y = LOAD8(b), r = _mm256_sub_epi32(x,y);
+    __m256i o = _mm256_and_si256(_mm256_xor_si256(x,y),_mm256_xor_si256(x,r));
+    STORE8(d,r);
+    STORE8(ovf,_mm256_srai_epi32(o,31));
+#elif defined(__SSE2__)
+    for(int h = 0;h<BATCH_WIDTH;h+=4){
+        __m128i x = LOAD4(a + h), y = LOAD4(b + h), r = _mm_sub_epi32(x,y);
+        __m128i o = _mm_and_si128(_mm_xor_si128(x,y),_mm_xor_si128(x,r));
+        STORE4(d + h,r);
+        STORE4(ovf + h,_mm_srai_epi32(o,31));
+    }
+#else
+    for(int i = 0;i<BATCH_WIDTH;i++)ovf[i] = __builtin_sub_overflow(a[i],b[i],&d[i]) ? -1 : 0;
+#endif
+}
+
+// d = a * b, ovf = -1 where the product does not fit in an int.
+static inline void chunk_mul(const int* a, const int* b, int* d, int* ovf){
+    for(int i = 0;i<BATCH_WIDTH;i++){
+        long long wide = (long long)a[i] * b[i];
+        d[i] = (int)wide;
+        ovf[i] = (wide < INT_MIN || wide > INT_MAX) ? -1 : 0;
+    }
+}
+
+// d = -1 where a > b (or a == b when equal is set), 0 elsewhere.
+static inline void chunk_compare(const int* a, const int* b, int* d, bool equal){
+#if defined(__AVX2__)
+    __m256i x = LOAD8(a), y = LOAD8(b);
+    STORE8(d,equal ? _mm256_cmpeq_epi32(x,y) : _mm256_cmpgt_epi32(x,y));
+#elif defined(__SSE2__)
+    for(int h = 0;h<BATCH_WIDTH;h+=4){
+        __m128i x = LOAD4(a + h), y = LOAD4(b + h);
+        STORE4(d + h,equal ? _mm_cmpeq_epi32(x,y) : _mm_cmpgt_epi32(x,y));
+    }
+#else
+    for(int i = 0;i<BATCH_WIDTH;i++)d[i] = (equal ? a[i] == b[i] : a[i] > b[i]) ? -1 : 0;
+#endif
+}
+
+// Turns a -1/0 mask into the language's 1/0 truth values, optionally negated.
+static inline void chunk_to_bool(int* d, bool negate){
+    for(int i = 0;i<BATCH_WIDTH;i++)d[i] = negate ? d[i] + 1 : d[i] & 1;
+}
+
+// d = -1 where v is non-zero.
+static inline void chunk_truthy(const int* v, int* d){
+    static const int zero[BATCH_WIDTH] = {0};
+    chunk_compare(v,zero,d,true);
+    for(int i = 0;i<BATCH_WIDTH;i++)d[i] = ~d[i];
+}
+
+// d = d & m, or d & ~m when invert is set.
+static inline void chunk_and(int* d, const int* m, bool invert){
+#if defined(__AVX2__)
+    __m256i x = LOAD8(d), y = LOAD8(m);
+    STORE8(d,invert ? _mm256_andnot_si256(y,x) : _mm256_and_si256(x,y));
+#elif defined(__SSE2__)
+    for(int h = 0;h<BATCH_WIDTH;h+=4){
+        __m128i x = LOAD4(d + h), y = LOAD4(m + h);
+        STORE4(d + h,invert ? _mm_andnot_si128(y,x) : _mm_and_si128(x,y));
+    }
+#else
+    for(int i = 0;i<BATCH_WIDTH;i++)d[i] = invert ? d[i] & ~m[i] : d[i] & m[i];
+#endif
+}
+
+// d = v in the lanes selected by m, unchanged elsewhere.
+static inline void chunk_blend(int* d, const int* v, const int* m){
+#if defined(__AVX2__)
+    STORE8(d,_mm256_blendv_epi8(LOAD8(d),LOAD8(v),LOAD8(m)));
+#elif defined(__SSE2__)
+    for(int h = 0;h<BATCH_WIDTH;h+=4){
+        __m128i mask = LOAD4(m + h);
+        STORE4(d + h,_mm_or_si128(_mm_and_si128(mask,LOAD4(v + h)),_mm_andnot_si128(mask,LOAD4(d + h))));
+    }
+#else
+    for(int i = 0;i<BATCH_WIDTH;i++)d[i] = (v[i] & m[i]) | (d[i] & ~m[i]);
+#endif
+}
+
+//============ LANE HELPERS ======================
+
+static int* acquire(Batch* b){
+    if(b->poolTop >= b->poolCapacity){
+        int capacity = (b->poolCapacity < 8) ? 8 : b->poolCapacity * 2;
+        b->pool = realloc(b->pool,sizeof(int*) * capacity);
+        for(int i = b->poolCapacity;i<capacity;i++)b->pool[i] = NULL;
+        b->poolCapacity = capacity;
+    }
+    int** slot = &b->pool[b->poolTop++];
+    if(*slot == NULL)*slot = calloc(b->padded,sizeof(int));
+    return *slot;
+}
+
+static void release(Batch* b, int count){
+    b->poolTop -= count;
+}
+
+// An empty lane set backed by two pool arrays (release 2 when done).
+static void acquireLanes(Batch* b, Lanes* lanes){
+    lanes->bits = acquire(b);
+    lanes->chunks = acquire(b);
+    lanes->count = 0;
+}
+
+// Drops retired lanes, then the chunks left without an active lane.
+static void retire(Batch* b, Lanes* lanes){
+    int kept = 0;
+    for(int k = 0;k<lanes->count;k++){
+        int c = lanes->chunks[k];
+        chunk_and(lanes->bits + c,b->alive + c,false);
+        if(chunk_any(lanes->bits + c))lanes->chunks[kept++] = c;
+    }
+    lanes->count = kept;
+}
+
+// Retires the lanes selected by `faulted` (all of them when faulted is
+// NULL) and reports the error once for the whole batch.
+static void fault(Batch* b, Lanes* lanes, const int* faulted, Token* token, const char* message){
+    int count = 0;
+    for(int k = 0;k<lanes->count;k++){
+        for(int i = lanes->chunks[k];i<lanes->chunks[k] + BATCH_WIDTH;i++){
+            if(!lanes->bits[i] || (faulted != NULL && !faulted[i]))continue;
+            b->alive[i] = 0;
+            if(b->laneFailed != NULL)b->laneFailed[i] = true;
+            count++;
+        }
+    }
+    retire(b,lanes);
+    if(count > 0){
+        fprintf(stderr, "[line %d] Runtime error at '%.*s': %s (%d lane%s)\n",
+                token->line, token->length, token->start, message, count, count == 1 ? "" : "s");
+    }
+}
+
+static void print(Batch* b, int lane, int value){
+    BatchOutput* prints = b->prints;
+    if(prints->count >= prints->capacity){
+        prints->capacity = (prints->capacity < 64) ? 64 : prints->capacity * 2;
+        prints->lanes = realloc(prints->lanes,sizeof(int) * prints->capacity);
+        prints->values = realloc(prints->values,sizeof(int) * prints->capacity);
+    }
+    prints->lanes[prints->count] = lane;
+    prints->values[prints->count] = value;
+    prints->count++;
+}
+
+//============ VARIABLES =========================
+
+static LaneVariable* findVariable(Batch* b, Token* name){
+    for(int i = 0;i<b->count;i++){
+        Token* other = &b->variables[i].name;
+        if(other->length == name->length && memcmp(other->start,name->start,name->length) == 0){
+            return &b->variables[i];
+        }
+    }
+    return NULL;
+}
+
+static LaneVariable* defineVariable(Batch* b, Token name){
+    LaneVariable* var = findVariable(b,&name);
+    if(var != NULL)return var;
+    if(b->count >= b->capacity){
+        b->capacity = (b->capacity < 8) ? 8 : b->capacity * 2;
+        b->variables = realloc(b->variables, sizeof(LaneVariable) * b->capacity);
+    }
+    var = &b->variables[b->count++];
+    var->name = name;
+    var->values = calloc(b->padded,sizeof(int));
+    return var;
+}
+
+//============ EXPRESSIONS =======================
+
+// Evaluates expr for the given lanes. The result is written to dst or,
+// for plain variable reads, the variable's own lanes are returned.
+// Lanes that fault are removed from the set.
+static const int* evaluate(Batch* b, Expr* expr, Lanes* lanes, int* dst);
+
+static void evaluateBinary(Batch* b, BinaryExpr* binary, Lanes* lanes, int* dst){
+    const int* left = evaluate(b,binary->left,lanes,dst);
+    // The right operand may assign to the variable the left one read.
+    if(left != dst){
+        for(int k = 0;k<lanes->count;k++){
+            int c = lanes->chunks[k];
+            memcpy(dst + c,left + c,sizeof(int) * BATCH_WIDTH);
+        }
+    }
+    int* scratch = acquire(b);
+    const int* right = evaluate(b,binary->right,lanes,scratch);
+    int* ovf = acquire(b);
+    bool overflowed = false;
+    token_type op = binary->op.type;
+    bool checked = binary->needsCheck;
+    const int* mask = lanes->bits;
+
+    for(int k = 0;k<lanes->count;k++){
+        int c = lanes->chunks[k];
+        int* d = dst + c;
+        const int* r = right + c;
+        // Proven safe by the range analysis: plain lane arithmetic. The proof
+        // only covers the active lanes, the others may hold anything, so the
+        // whole chunk is computed with wrapping unsigned arithmetic.
+        if(!checked && (op == TOKEN_PLUS || op == TOKEN_MINUS || op == TOKEN_STAR)){
+            for(int i = 0;i<BATCH_WIDTH;i++){
+                if(op == TOKEN_PLUS)d[i] = (int)((unsigned int)d[i] + (unsigned int)r[i]);
+                else if(op == TOKEN_MINUS)d[i] = (int)((unsigned int)d[i] - (unsigned int)r[i]);
+                else d[i] = (int)((unsigned int)d[i] * (unsigned int)r[i]);
+            }
+            continue;
+        }
+        switch(op){
+            case TOKEN_PLUS:  chunk_add(d,r,d,ovf + c); break;
+            case TOKEN_MINUS: chunk_sub(d,r,d,ovf + c); break;
+            case TOKEN_STAR:  chunk_mul(d,r,d,ovf + c); break;
+            case TOKEN_SLASH:
+                // No SIMD integer division, so divide the active lanes one by one.
+                for(int i = 0;i<BATCH_WIDTH;i++){
+                    ovf[c + i] = 0;
+                    if(!mask[c + i])continue;
+                    if(checked && (r[i] == 0 || (d[i] == INT_MIN && r[i] == -1)))ovf[c + i] = -1;
+                    else d[i] = d[i] / r[i];
+                }
+                break;
+            case TOKEN_GREATER:       chunk_compare(d,r,d,false); chunk_to_bool(d,false); break;
+            case TOKEN_SMALLER:       chunk_compare(r,d,d,false); chunk_to_bool(d,false); break;
+            case TOKEN_GREATER_EQUAL: chunk_compare(r,d,d,false); chunk_to_bool(d,true); break;
+            case TOKEN_SMALLER_EQUAL: chunk_compare(d,r,d,false); chunk_to_bool(d,true); break;
+            case TOKEN_EQUAL_EQUAL:   chunk_compare(d,r,d,true); chunk_to_bool(d,false); break;
+            case TOKEN_BANG_EQUAL:    chunk_compare(d,r,d,true); chunk_to_bool(d,true); break;
+            default: break;
+        }
+        if(op == TOKEN_PLUS || op == TOKEN_MINUS || op == TOKEN_STAR || op == TOKEN_SLASH){
+            chunk_and(ovf + c,mask + c,false);
+            if(chunk_any(ovf + c))overflowed = true;
+        }
+    }
+    if(overflowed){
+        bool zero = false;
+        for(int k = 0;op == TOKEN_SLASH && k<lanes->count;k++){
+            for(int i = lanes->chunks[k];i<lanes->chunks[k] + BATCH_WIDTH;i++)if(ovf[i] && right[i] == 0)zero = true;
+        }
+        fault(b,lanes,ovf,&binary->op,zero ? "Division by zero." : "Integer overflow.");
+    }
+    release(b,2);
+}
+
+static void evaluateUnary(Batch* b, UnaryExpr* unary, Lanes* lanes, int* dst){
+    const int* right = evaluate(b,unary->right,lanes,dst);
+    if(unary->op.type == TOKEN_PLUS){
+        for(int k = 0;right != dst && k<lanes->count;k++){
+            int c = lanes->chunks[k];
+            memcpy(dst + c,right + c,sizeof(int) * BATCH_WIDTH);
+        }
+        return;
+    }
+    int* ovf = acquire(b);
+    bool overflowed = false;
+    for(int k = 0;k<lanes->count;k++){
+        for(int i = lanes->chunks[k];i<lanes->chunks[k] + BATCH_WIDTH;i++){
+            ovf[i] = 0;
+            if(unary->op.type == TOKEN_BANG)dst[i] = !right[i];
+            else if(unary->needsCheck && right[i] == INT_MIN)ovf[i] = lanes->bits[i];
+            else dst[i] = (int)(0u - (unsigned int)right[i]);    // inactive lanes may hold INT_MIN
+            if(ovf[i])overflowed = true;
+        }
+    }
+    if(overflowed)fault(b,lanes,ovf,&unary->op,"Integer overflow.");
+    release(b,1);
+}
+
+static const int* evaluate(Batch* b, Expr* expr, Lanes* lanes, int* dst){
+    switch(expr->type){
+        case EXPR_LITERAL:
+            // Broadcast into the chunks in use only.
+            for(int k = 0;k<lanes->count;k++){
+                int* d = dst + lanes->chunks[k];
+                for(int i = 0;i<BATCH_WIDTH;i++)d[i] = expr->as.literal.value;
+            }
+            return dst;
+        case EXPR_GROUPING:
+            return evaluate(b,expr->as.grouping.expression,lanes,dst);
+        case EXPR_VARIABLE:{
+            LaneVariable* var = findVariable(b,&expr->as.variable.name);
+            if(var == NULL){
+                fault(b,lanes,NULL,&expr->as.variable.name,"Undefined variable.");
+                return dst;
+            }
+            return var->values;
+        }
+        case EXPR_ASSIGN:{
+            LaneVariable* var = findVariable(b,&expr->as.assign.name);
+            if(var == NULL){
+                fault(b,lanes,NULL,&expr->as.assign.name,"Undefined variable.");
+                return dst;
+            }
+            const int* value = evaluate(b,expr->as.assign.value,lanes,dst);
+            for(int k = 0;k<lanes->count;k++){
+                int c = lanes->chunks[k];
+                chunk_blend(var->values + c,value + c,lanes->bits + c);
+            }
+            return value;
+        }
+        case EXPR_BINARY:
+            evaluateBinary(b,&expr->as.binary,lanes,dst);
+            return dst;
+        case EXPR_UNARY:
+            evaluateUnary(b,&expr->as.unary,lanes,dst);
+            return dst;
+    }
+    return dst;
+}
+
+//============ STATEMENTS ========================
+
+// Narrows `lanes` to the ones where condition holds, chunk by chunk, and
+// puts the others in `rest` when it is given.
+static void split(Lanes* lanes, const int* condition, Lanes* rest){
+    int kept = 0;
+    for(int k = 0;k<lanes->count;k++){
+        int c = lanes->chunks[k];
+        int truthy[BATCH_WIDTH];
+        chunk_truthy(condition + c,truthy);
+        if(rest != NULL){
+            memcpy(rest->bits + c,lanes->bits + c,sizeof(int) * BATCH_WIDTH);
+            chunk_and(rest->bits + c,truthy,true);
+            if(chunk_any(rest->bits + c))rest->chunks[rest->count++] = c;
+        }
+        chunk_and(lanes->bits + c,truthy,false);
+        if(chunk_any(lanes->bits + c))lanes->chunks[kept++] = c;
+    }
+    lanes->count = kept;
+}
+
+static void copyLanes(const Lanes* from, Lanes* to){
+    for(int k = 0;k<from->count;k++){
+        int c = from->chunks[k];
+        memcpy(to->bits + c,from->bits + c,sizeof(int) * BATCH_WIDTH);
+        to->chunks[k] = c;
+    }
+    to->count = from->count;
+}
+
+static void execute(Batch* b, Stmt* stmt, Lanes* lanes){
+    // Lanes retired by an error anywhere drop out of every enclosing set.
+    retire(b,lanes);
+    if(lanes->count == 0)return;
+
+    switch(stmt->type){
+        case STMT_EXPRESSION:{
+            int* dst = acquire(b);
+            evaluate(b,stmt->as.expression.expression,lanes,dst);
+            release(b,1);
+            break;
+        }
+        case STMT_PRINT:{
+            int* dst = acquire(b);
+            const int* value = evaluate(b,stmt->as.print.expression,lanes,dst);
+            for(int k = 0;b->prints != NULL && k<lanes->count;k++){
+                for(int i = lanes->chunks[k];i<lanes->chunks[k] + BATCH_WIDTH;i++)if(lanes->bits[i])print(b,i,value[i]);
+            }
+            release(b,1);
+            break;
+        }
+        case STMT_VAR_DECLARATION:{
+            LaneVariable* var = defineVariable(b,stmt->as.var.name);
+            if(stmt->as.var.initializer == NULL){
+                static const int zero[BATCH_WIDTH] = {0};
+                for(int k = 0;k<lanes->count;k++){
+                    int c = lanes->chunks[k];
+                    chunk_blend(var->values + c,zero,lanes->bits + c);
+                }
+                break;
+            }
+            int* dst = acquire(b);
+            const int* value = evaluate(b,stmt->as.var.initializer,lanes,dst);
+            // The initializer cannot declare variables, so var is still valid.
+            for(int k = 0;k<lanes->count;k++){
+                int c = lanes->chunks[k];
+                chunk_blend(var->values + c,value + c,lanes->bits + c);
+            }
+            release(b,1);
+            break;
+        }
+        case STMT_IF:{
+            int* dst = acquire(b);
+            Lanes thenLanes, elseLanes;
+            acquireLanes(b,&thenLanes);
+            acquireLanes(b,&elseLanes);
+            const int* condition = evaluate(b,stmt->as.ifStmt.condition,lanes,dst);
+            copyLanes(lanes,&thenLanes);
+            split(&thenLanes,condition,&elseLanes);
+            execute(b,stmt->as.ifStmt.thenBranch,&thenLanes);
+            if(stmt->as.ifStmt.elseBranch != NULL)execute(b,stmt->as.ifStmt.elseBranch,&elseLanes);
+            release(b,5);
+            break;
+        }
+        case STMT_WHILE:{
+            int* dst = acquire(b);
+            Lanes loopLanes;
+            acquireLanes(b,&loopLanes);
+            copyLanes(lanes,&loopLanes);
+            for(;;){
+                retire(b,&loopLanes);
+                const int* condition = evaluate(b,stmt->as.whileStmt.condition,&loopLanes,dst);
+                // Lanes whose condition failed leave the loop for good, and
+                // so do their chunks once all of their lanes have left.
+                split(&loopLanes,condition,NULL);
+                if(loopLanes.count == 0)break;
+                execute(b,stmt->as.whileStmt.body,&loopLanes);
+            }
+            release(b,3);
+            break;
+        }
+        case STMT_BLOCK:
+            break;
+    }
+}
+
+//============ PRINTED OUTPUT ====================
+
+void batch_output_init(BatchOutput* prints){
+    prints->lanes = NULL;
+    prints->values = NULL;
+    prints->count = 0;
+    prints->capacity = 0;
+    prints->starts = NULL;
+}
+
+// Groups the prints by lane (a stable counting sort), keeping each lane's
+// values in the order they were printed.
+static void groupPrints(BatchOutput* prints, int lanes){
+    int* starts = calloc(lanes + 1,sizeof(int));
+    for(int i = 0;i<prints->count;i++)starts[prints->lanes[i] + 1]++;
+    for(int i = 0;i<lanes;i++)starts[i + 1] += starts[i];
+    int* next = malloc(sizeof(int) * (lanes > 0 ? lanes : 1));
+    memcpy(next,starts,sizeof(int) * lanes);
+    int* grouped = malloc(sizeof(int) * (prints->count > 0 ? prints->count : 1));
+    for(int i = 0;i<prints->count;i++)grouped[next[prints->lanes[i]]++] = prints->values[i];
+    free(next);
+    free(prints->lanes);
+    free(prints->values);
+    prints->lanes = NULL;
+    prints->values = grouped;
+    prints->capacity = prints->count;
+    prints->starts = starts;
+}
+
+void batch_output_write(BatchOutput* prints, int lane, Output* out){
+    for(int i = prints->starts[lane];i<prints->starts[lane + 1];i++)output_int_line(out,prints->values[i]);
+}
+
+void batch_output_free(BatchOutput* prints){
+    free(prints->lanes);
+    free(prints->values);
+    free(prints->starts);
+    batch_output_init(prints);
+}
+
+//============ PUBLIC INTERFACE ==================
+
+int run_batch(Stmt** statements, int count, const char** names, int nameCount,
+              int* frames, int lanes, BatchOutput* prints, bool* laneFailed){
+    Batch b;
+    b.lanes = lanes;
+    b.padded = (lanes + BATCH_WIDTH - 1) / BATCH_WIDTH * BATCH_WIDTH;
+    b.variables = NULL;
+    b.count = 0;
+    b.capacity = 0;
+    b.pool = NULL;
+    b.poolTop = 0;
+    b.poolCapacity = 0;
+    b.prints = prints;
+    b.laneFailed = laneFailed;
+    b.alive = calloc(b.padded,sizeof(int));
+    for(int i = 0;i<lanes;i++)b.alive[i] = -1;
+    if(laneFailed != NULL)for(int i = 0;i<lanes;i++)laneFailed[i] = false;
+
+    // Transpose the input frames into one lane array per variable. A name
+    // given twice shares one variable, so the variable of every name is
+    // remembered by index (declarations may move the array).
+    int* seeded = malloc(sizeof(int) * (nameCount > 0 ? nameCount : 1));
+    for(int j = 0;j<nameCount;j++){
+        Token name;
+        name.type = TOKEN_IDENTIFIER;
+        name.start = names[j];
+        name.length = (int)strlen(names[j]);
+        name.line = 0;
+        LaneVariable* var = defineVariable(&b,name);
+        seeded[j] = (int)(var - b.variables);
+        for(int i = 0;i<lanes;i++)var->values[i] = frames[i * nameCount + j];
+    }
+
+    // Top-level statements run for every lane still alive; the set only
+    // shrinks, so it is narrowed in place.
+    Lanes all;
+    acquireLanes(&b,&all);
+    for(int c = 0;c<b.padded;c+=BATCH_WIDTH){
+        memcpy(all.bits + c,b.alive + c,sizeof(int) * BATCH_WIDTH);
+        all.chunks[all.count++] = c;
+    }
+    for(int i = 0;i<count;i++)execute(&b,statements[i],&all);
+
+    for(int j = 0;j<nameCount;j++){
+        LaneVariable* var = &b.variables[seeded[j]];
+        for(int i = 0;i<lanes;i++)frames[i * nameCount + j] = var->values[i];
+    }
+    free(seeded);
+    if(prints != NULL)groupPrints(prints,lanes);
+
+    int completed = 0;
+    for(int i = 0;i<lanes;i++)if(b.alive[i])completed++;
+
+    for(int i = 0;i<b.count;i++)free(b.variables[i].values);
+    for(int i = 0;i<b.poolCapacity;i++)free(b.pool[i]);
+    free(b.variables);
+    free(b.pool);
+    free(b.alive);
+    return completed;
+}
@@ -0,0 +1,48 @@
+#ifndef BATCH_HEADER_H
+#define BATCH_HEADER_H
+#include "stdbool.h"
+#include "../Parsers/RecursiveDescentParser/AST.h"
+#include "output.h"
+
+// Number of 32-bit lanes evaluated together (one AVX2 register).
+#define BATCH_WIDTH 8
+
+// What the lanes printed, in one arena shared by all of them: every print
+// adds a (lane, value) pair, so lanes that print little cost little. Once
+// the program is done run_batch groups the values by lane.
+typedef struct{
+    int* lanes;     // lane of every print, until grouped
+    int* values;
+    int count;
+    int capacity;
+    int* starts;    // after grouping: lane i printed values[starts[i]] up to values[starts[i + 1]]
+}BatchOutput;
+
+void batch_output_init(BatchOutput* prints);
+// Writes the lines `lane` printed, as a print statement would have.
+void batch_output_write(BatchOutput* prints, int lane, Output* out);
+void batch_output_free(BatchOutput* prints);
+
+// Runs one program over many inputs at once ("one program, many inputs").
+//
+// frames holds `lanes` input frames of `nameCount` ints each, frame i at
+// frames[i * nameCount]. Value j of a frame seeds variable names[j] in
+// that lane and receives its final value once the program is done. Seeded
+// variables are ordinary variables: a declaration of the same name in the
+// program (`int x = 0;`) overwrites the frame's value, exactly as running
+// interpret() after interpreter_define() would.
+// Every lane follows its own path through if/while: divergent control
+// flow is handled with lane masks, and each mask lists the chunks of
+// BATCH_WIDTH lanes that still have an active lane. A chunk whose lanes
+// all finished or failed is no longer visited, so a long loop in a few
+// lanes costs time in proportion to those lanes, not to the whole batch.
+//
+// prints: NULL or an initialised BatchOutput for the print statements.
+// laneFailed: NULL or one flag per lane, set when that lane hit a runtime
+// error (such lanes are retired and keep the values they had).
+//
+// Returns the number of lanes that completed without error.
+int run_batch(Stmt** statements, int count, const char** names, int nameCount,
+              int* frames, int lanes, BatchOutput* prints, bool* laneFailed);
+
+#endif
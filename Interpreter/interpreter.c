@@ -0,0 +1,224 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "limits.h"
+#include "interpreter.h"
+
+//============ ERRORS ============================
+
+static void runtimeError(Interpreter* interp, Token* token, const char* message){
+    if(interp->hadError)return;
+    interp->hadError = true;
+    fprintf(stderr, "[line %d] Runtime error at '%.*s': %s\n", token->line, token->length, token->start, message);
+}
+
+//============ VARIABLES =========================
+
+static Variable* findVariable(Interpreter* interp, Token* name){
+    for(int i = 0;i<interp->count;i++){
+        Token* other = &interp->variables[i].name;
+        if(other->length == name->length && memcmp(other->start,name->start,name->length) == 0){
+            return &interp->variables[i];
+        }
+    }
+    return NULL;
+}
+
+static void defineVariable(Interpreter* interp, Token name, int value){
+    Variable* var = findVariable(interp,&name);
+    if(var != NULL){
+        var->value = value;
+        return;
+    }
+    if(interp->count >= interp->capacity){
+        interp->capacity = (interp->capacity < 8) ? 8 : interp->capacity * 2;
+        interp->variables = realloc(interp->variables, sizeof(Variable) * interp->capacity);
+    }
+    interp->variables[interp->count].name = name;
+    interp->variables[interp->count].value = value;
+    interp->count++;
+}
+
+//============ EXPRESSIONS =======================
+
+static int evaluate(Interpreter* interp, Expr* expr);
+
+static int evaluateBinary(Interpreter* interp, BinaryExpr* binary){
+    int left = evaluate(interp,binary->left);
+    if(interp->hadError)return 0;
+    int right = evaluate(interp,binary->right);
+    if(interp->hadError)return 0;
+
+    // Proven safe by the range analysis: no checks needed.
+    if(!binary->needsCheck){
+        switch(binary->op.type){
+            case TOKEN_PLUS:  return left + right;
+            case TOKEN_MINUS: return left - right;
+            case TOKEN_STAR:  return left * right;
+            case TOKEN_SLASH: return left / right;
+            default: break;
+        }
+    }
+
+    int result = 0;
+    switch(binary->op.type){
+        case TOKEN_PLUS:
+            if(__builtin_add_overflow(left,right,&result))runtimeError(interp,&binary->op,"Integer overflow.");
+            return result;
+        case TOKEN_MINUS:
+            if(__builtin_sub_overflow(left,right,&result))runtimeError(interp,&binary->op,"Integer overflow.");
+            return result;
+        case TOKEN_STAR:
+            if(__builtin_mul_overflow(left,right,&result))runtimeError(interp,&binary->op,"Integer overflow.");
+            return result;
+        case TOKEN_SLASH:
+            if(right == 0){
+                runtimeError(interp,&binary->op,"Division by zero.");
+                return 0;
+            }
+            if(left == INT_MIN && right == -1){
+                runtimeError(interp,&binary->op,"Integer overflow.");
+                return 0;
+            }
+            return left / right;
+        case TOKEN_GREATER:       return left > right;
+        case TOKEN_GREATER_EQUAL: return left >= right;
+        case TOKEN_SMALLER:       return left < right;
+        case TOKEN_SMALLER_EQUAL: return left <= right;
+        case TOKEN_EQUAL_EQUAL:   return left == right;
+        case TOKEN_BANG_EQUAL:    return left != right;
+        default:
+            runtimeError(interp,&binary->op,"Unknown binary operator.");
+            return 0;
+    }
+}
+
+static int evaluateUnary(Interpreter* interp, UnaryExpr* unary){
+    int right = evaluate(interp,unary->right);
+    if(interp->hadError)return 0;
+    switch(unary->op.type){
+        case TOKEN_MINUS:
+            if(unary->needsCheck && right == INT_MIN){
+                runtimeError(interp,&unary->op,"Integer overflow.");
+                return 0;
+            }
+            return -right;
+        case TOKEN_PLUS: return right;
+        case TOKEN_BANG: return !right;
+        default:
+            runtimeError(interp,&unary->op,"Unknown unary operator.");
+            return 0;
+    }
+}
+
+static int evaluate(Interpreter* interp, Expr* expr){
+    switch(expr->type){
+        case EXPR_LITERAL:
+            return expr->as.literal.value;
+        case EXPR_GROUPING:
+            return evaluate(interp,expr->as.grouping.expression);
+        case EXPR_VARIABLE:{
+            Variable* var = findVariable(interp,&expr->as.variable.name);
+            if(var == NULL){
+                runtimeError(interp,&expr->as.variable.name,"Undefined variable.");
+                return 0;
+            }
+            return var->value;
+        }
+        case EXPR_ASSIGN:{
+            Variable* var = findVariable(interp,&expr->as.assign.name);
+            if(var == NULL){
+                runtimeError(interp,&expr->as.assign.name,"Undefined variable.");
+                return 0;
+            }
+            int value = evaluate(interp,expr->as.assign.value);
+            // A failed right-hand side leaves the variable as it was.
+            if(interp->hadError)return 0;
+            var->value = value;
+            return value;
+        }
+        case EXPR_BINARY:
+            return evaluateBinary(interp,&expr->as.binary);
+        case EXPR_UNARY:
+            return evaluateUnary(interp,&expr->as.unary);
+    }
+    return 0;
+}
+
+//============ STATEMENTS ========================
+
+static void execute(Interpreter* interp, Stmt* stmt);
+
+static void executeStmt(Interpreter* interp, Stmt* stmt){
+    switch(stmt->type){
+        case STMT_EXPRESSION:
+            evaluate(interp,stmt->as.expression.expression);
+            break;
+        case STMT_PRINT:{
+            int value = evaluate(interp,stmt->as.print.expression);
+            if(!interp->hadError)output_int_line(interp->out,value);
+            break;
+        }
+        case STMT_VAR_DECLARATION:{
+            int value = 0;
+            if(stmt->as.var.initializer != NULL)value = evaluate(interp,stmt->as.var.initializer);
+            if(!interp->hadError)defineVariable(interp,stmt->as.var.name,value);
+            break;
+        }
+        case STMT_IF:{
+            int condition = evaluate(interp,stmt->as.ifStmt.condition);
+            if(interp->hadError)break;
+            if(condition)execute(interp,stmt->as.ifStmt.thenBranch);
+            else if(stmt->as.ifStmt.elseBranch != NULL)execute(interp,stmt->as.ifStmt.elseBranch);
+            break;
+        }
+        case STMT_WHILE:
+            while(evaluate(interp,stmt->as.whileStmt.condition) && !interp->hadError){
+                execute(interp,stmt->as.whileStmt.body);
+                if(interp->hadError)break;
+            }
+            break;
+        case STMT_BLOCK:
+            break;
+    }
+}
+
+static void execute(Interpreter* interp, Stmt* stmt){
+    if(interp->profiler == NULL){
+        executeStmt(interp,stmt);
+        return;
+    }
+    profiler_enter(interp->profiler,stmt);
+    executeStmt(interp,stmt);
+    profiler_exit(interp->profiler);
+}
+
+//============ PUBLIC INTERFACE ==================
+
+void interpreter_init(Interpreter* interp, Output* out){
+    interp->variables = NULL;
+    interp->count = 0;
+    interp->capacity = 0;
+    interp->out = out;
+    interp->hadError = false;
+    interp->profiler = NULL;
+}
+
+void interpreter_define(Interpreter* interp, Token name, int value){
+    defineVariable(interp,name,value);
+}
+
+bool interpret(Interpreter* interp, Stmt** statements, int count){
+    interp->hadError = false;
+    for(int i = 0;i<count;i++){
+        execute(interp,statements[i]);
+        if(interp->hadError)break;
+    }
+    output_flush(interp->out);
+    return !interp->hadError;
+}
+
+void interpreter_free(Interpreter* interp){
+    free(interp->variables);
+    interpreter_init(interp,interp->out);
+}
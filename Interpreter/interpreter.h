@@ -0,0 +1,37 @@
+#ifndef INTERPRETER_HEADER_H
+#define INTERPRETER_HEADER_H
+#include "stdbool.h"
+#include "../Lexer/lexer.h"
+#include "../Parsers/RecursiveDescentParser/AST.h"
+#include "output.h"
+#include "../Profiler/profiler.h"
+
+typedef struct{
+    Token name;
+    int value;
+}Variable;
+
+// Tree walking interpreter. All state of one execution lives here, so
+// several programs can run side by side with their own output sinks.
+typedef struct{
+    Variable* variables;
+    int count;
+    int capacity;
+    Output* out;
+    bool hadError;
+    Profiler* profiler;     // when set, told about every statement executed
+}Interpreter;
+
+void interpreter_init(Interpreter* interp, Output* out);
+
+// Creates (or overwrites) a variable before the program runs, e.g. to seed
+// an input. The name's characters must outlive the interpreter.
+void interpreter_define(Interpreter* interp, Token name, int value);
+
+// Executes the statements in order. Returns false on a runtime error.
+// Variables persist across calls, pending output is flushed on return.
+bool interpret(Interpreter* interp, Stmt** statements, int count);
+
+void interpreter_free(Interpreter* interp);
+
+#endif
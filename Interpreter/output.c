@@ -0,0 +1,201 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "errno.h"
+#include "output.h"
+#ifdef _WIN32
+#include "io.h"
+#else
+#include "unistd.h"
+#include "sys/uio.h"
+#endif
+
+//============ SINK INITIALISATION ===============
+
+static void init_common(Output* out, sink_type type){
+    out->sink.type = type;
+    out->sink.fd = -1;
+    out->sink.memory = NULL;
+    out->sink.memoryLength = 0;
+    out->sink.memoryCapacity = 0;
+    out->sink.callback = NULL;
+    out->sink.user = NULL;
+    out->length = 0;
+    out->hadError = false;
+}
+
+void output_init_fd(Output* out, int fd){
+    init_common(out,SINK_FD);
+    out->sink.fd = fd;
+}
+
+void output_init_memory(Output* out){
+    init_common(out,SINK_MEMORY);
+}
+
+void output_init_callback(Output* out, OutputCallback callback, void* user){
+    init_common(out,SINK_CALLBACK);
+    out->sink.callback = callback;
+    out->sink.user = user;
+}
+
+//============ SINK BACKENDS =====================
+
+static void fd_write_all(Output* out, const char* data, int length){
+    while(length > 0){
+#ifdef _WIN32
+        int n = _write(out->sink.fd,data,length);
+#else
+        ssize_t n = write(out->sink.fd,data,length);
+#endif
+        if(n < 0){
+            if(errno == EINTR)continue;
+            out->hadError = true;
+            return;
+        }
+        data += n;
+        length -= (int)n;
+    }
+}
+
+// Hands up to two contiguous segments to the fd in a single system call
+// when possible, falling back to plain writes after a short write.
+static void fd_write_segments(Output* out, const char* a, int aLength, const char* b, int bLength){
+#ifndef _WIN32
+    if(bLength > 0){
+        struct iovec iov[2];
+        iov[0].iov_base = (void*)a;
+        iov[0].iov_len = aLength;
+        iov[1].iov_base = (void*)b;
+        iov[1].iov_len = bLength;
+        ssize_t n;
+        do n = writev(out->sink.fd,iov,2);
+        while(n < 0 && errno == EINTR);
+        if(n < 0){
+            out->hadError = true;
+            return;
+        }
+        if(n >= aLength + bLength)return;
+        if(n < aLength){
+            fd_write_all(out,a + n,aLength - (int)n);
+            fd_write_all(out,b,bLength);
+        }else fd_write_all(out,b + (n - aLength),bLength - (int)(n - aLength));
+        return;
+    }
+#endif
+    fd_write_all(out,a,aLength);
+    fd_write_all(out,b,bLength);
+}
+
+static void memory_append(Output* out, const char* data, int length){
+    if(length == 0)return;
+    OutputSink* sink = &out->sink;
+    if(sink->memoryLength + length > sink->memoryCapacity){
+        int capacity = sink->memoryCapacity < OUTPUT_BUFFER_SIZE ? OUTPUT_BUFFER_SIZE : sink->memoryCapacity;
+        while(capacity < sink->memoryLength + length)capacity *= 2;
+        char* memory = realloc(sink->memory,capacity);
+        if(memory == NULL){
+            out->hadError = true;
+            return;
+        }
+        sink->memory = memory;
+        sink->memoryCapacity = capacity;
+    }
+    memcpy(sink->memory + sink->memoryLength,data,length);
+    sink->memoryLength += length;
+}
+
+static void sink_write(Output* out, const char* a, int aLength, const char* b, int bLength){
+    switch(out->sink.type){
+        case SINK_FD:
+            fd_write_segments(out,a,aLength,b,bLength);
+            break;
+        case SINK_MEMORY:
+            memory_append(out,a,aLength);
+            memory_append(out,b,bLength);
+            break;
+        case SINK_CALLBACK:
+            if(aLength > 0)out->sink.callback(out->sink.user,a,aLength);
+            if(bLength > 0)out->sink.callback(out->sink.user,b,bLength);
+            break;
+    }
+}
+
+//============ BATCH BUFFER ======================
+
+void output_flush(Output* out){
+    if(out->length == 0)return;
+    sink_write(out,out->buffer,out->length,NULL,0);
+    out->length = 0;
+}
+
+void output_write(Output* out, const char* data, int length){
+    if(out->length + length <= OUTPUT_BUFFER_SIZE){
+        memcpy(out->buffer + out->length,data,length);
+        out->length += length;
+        return;
+    }
+    // Full: hand the batch and the new bytes over together instead of
+    // copying them in after a flush.
+    sink_write(out,out->buffer,out->length,data,length);
+    out->length = 0;
+}
+
+//============ INTEGER FORMATTING ================
+
+static const char digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+void output_int_line(Output* out, int value){
+    // 10 digits, a sign and the newline.
+    char text[12];
+    char* end = text + sizeof(text);
+    char* p = end;
+    *--p = '\n';
+
+    // Work on the magnitude as unsigned so INT_MIN does not overflow.
+    unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    while(magnitude >= 100){
+        unsigned int pair = (magnitude % 100) * 2;
+        magnitude /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if(magnitude >= 10){
+        *--p = digit_pairs[magnitude * 2 + 1];
+        *--p = digit_pairs[magnitude * 2];
+    }else *--p = (char)('0' + magnitude);
+    if(value < 0)*--p = '-';
+
+    output_write(out,p,(int)(end - p));
+}
+
+//============ MEMORY SINK =======================
+
+const char* output_memory_data(Output* out, int* length){
+    output_flush(out);
+    *length = out->sink.memoryLength;
+    return out->sink.memory;
+}
+
+void output_memory_reset(Output* out){
+    output_flush(out);
+    out->sink.memoryLength = 0;
+}
+
+void output_free(Output* out){
+    output_flush(out);
+    free(out->sink.memory);
+    out->sink.memory = NULL;
+    out->sink.memoryLength = 0;
+    out->sink.memoryCapacity = 0;
+}
@@ -0,0 +1,55 @@
+#ifndef OUTPUT_HEADER_H
+#define OUTPUT_HEADER_H
+#include "stdbool.h"
+
+// Size of the per-execution batch buffer.
+#define OUTPUT_BUFFER_SIZE 8192
+
+typedef enum{
+    SINK_FD,        // write()/writev() to a file descriptor
+    SINK_MEMORY,    // append to a growable heap buffer
+    SINK_CALLBACK   // hand every flushed batch to a host function
+}sink_type;
+
+// Receives every flushed batch, possibly in two consecutive calls.
+typedef void (*OutputCallback)(void* user, const char* data, int length);
+
+typedef struct{
+    sink_type type;
+    int fd;
+    char* memory;
+    int memoryLength;
+    int memoryCapacity;
+    OutputCallback callback;
+    void* user;
+}OutputSink;
+
+// Everything a program prints goes through one of these. Bytes are gathered
+// in a linear buffer and only handed to the sink in large batches: when a
+// write does not fit, the buffered bytes and the new ones leave together
+// (one writev() for fd sinks) and the buffer starts over empty.
+typedef struct{
+    OutputSink sink;
+    char buffer[OUTPUT_BUFFER_SIZE];
+    int length;     // number of unflushed bytes
+    bool hadError;
+}Output;
+
+void output_init_fd(Output* out, int fd);
+void output_init_memory(Output* out);
+void output_init_callback(Output* out, OutputCallback callback, void* user);
+
+void output_write(Output* out, const char* data, int length);
+// Appends the decimal form of value followed by a newline.
+void output_int_line(Output* out, int value);
+void output_flush(Output* out);
+
+// Memory sink only: flushes and returns everything printed so far
+// (not NUL terminated).
+const char* output_memory_data(Output* out, int* length);
+void output_memory_reset(Output* out);
+
+// Flushes pending bytes and releases the memory sink's buffer.
+void output_free(Output* out);
+
+#endif
@@ -44,10 +44,8 @@ void skip_white_space(Lexer* lex){
             lex->line++;
             advance(lex);
         }else if(peek(lex) == '/' && next_peek(lex) == '/'){
-            while(true){
-                char ch = advance(lex);
-                if(ch == '\n' || is_end(ch))break;
-            }
+            // Stop at the newline so the branch above counts it.
+            while(peek(lex) != '\n' && !is_end(peek(lex)))advance(lex);
         }
         else break;
     }
@@ -115,6 +113,7 @@ Token error_token(Lexer* lex,const char* str){
     err.start = str;
     err.type = TOKEN_ERROR;
     err.length = get_size(str);
+    return err;
 }
 
 Token scan_token(Lexer* lex){
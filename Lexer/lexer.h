@@ -22,7 +22,9 @@ typedef enum{
     //Keywords
     TOKEN_IF, TOKEN_ELSE,
     TOKEN_INT, TOKEN_WHILE,
-    TOKEN_PRINT
+    TOKEN_PRINT,
+
+    TOKEN_COUNT
 
 }token_type;
 
@@ -0,0 +1,207 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "stdbool.h"
+#include "LL1parser.h"
+#include "LL1table.h"
+
+LL1Parser ll1;
+
+//============ HELPER FUNCTIONS ==================
+
+static void errorAt(Token* token, const char* message, const char* name) {
+    if (ll1.hadError) return;
+    ll1.hadError = true;
+    fprintf(stderr, "[line %d] Error", token->line);
+
+    if (token->type == TOKEN_EOF) {
+        fprintf(stderr, " at end");
+    } else if (token->type != TOKEN_ERROR) {
+        fprintf(stderr, " at '%.*s'", token->length, token->start);
+    }
+
+    fprintf(stderr, ": ");
+    fprintf(stderr, message, name);
+    fprintf(stderr, "\n");
+}
+
+static void advance(){
+    for(;;){
+        ll1.current = scan_token(&ll1.lexer);
+        if(ll1.current.type != TOKEN_ERROR)break;
+    }
+}
+
+static void pushValue(Token token, Expr* expr, Stmt* stmt){
+    if(ll1.valueCount >= ll1.valueCapacity){
+        ll1.valueCapacity = (ll1.valueCapacity < 64) ? 64 : ll1.valueCapacity * 2;
+        ll1.values = realloc(ll1.values, sizeof(LL1Value) * ll1.valueCapacity);
+    }
+    LL1Value* value = &ll1.values[ll1.valueCount++];
+    value->token = token;
+    value->expr = expr;
+    value->stmt = stmt;
+    value->target = false;
+}
+
+static void addStatement(Stmt* stmt){
+    if (ll1.count >= ll1.capacity) {
+        ll1.capacity = (ll1.capacity < 8) ? 8 : ll1.capacity * 2;
+        ll1.statements = realloc(ll1.statements, sizeof(Stmt*) * ll1.capacity);
+    }
+    ll1.statements[ll1.count++] = stmt;
+}
+
+// Replaces the top `count` values with `result`. The result keeps the
+// token of the first value, which is the first token of the construct.
+static void collapse(int count, Expr* expr, Stmt* stmt){
+    ll1.valueCount -= count - 1;
+    LL1Value* value = &ll1.values[ll1.valueCount - 1];
+    value->expr = expr;
+    value->stmt = stmt;
+    value->target = false;
+    if(stmt != NULL)stmt->line = value->token.line;
+}
+
+//=========== SEMANTIC ACTIONS ===================
+// `top` points one past the last value; each production's symbols left one
+// value apiece (see LL1table.h), so top[-1] belongs to its last symbol.
+
+static void reduce(int production){
+    if(ll1Productions[production].action == LL1_EMPTY){
+        pushValue(ll1.current,NULL,NULL);
+        return;
+    }
+    LL1Value* top = ll1.values + ll1.valueCount;
+    switch(production){
+        case P_program_rep1_0:
+            addStatement(top[-1].stmt);
+            ll1.valueCount--;
+            break;
+        case P_var_declaration_0:
+            collapse(4,NULL,newVarDeclStmt(top[-3].token,top[-2].expr));
+            break;
+        case P_var_declaration_opt1_0:
+        case P_if_statement_opt1_0:
+            top[-2].expr = top[-1].expr;
+            top[-2].stmt = top[-1].stmt;
+            ll1.valueCount--;
+            break;
+        case P_expr_statement_0:
+            collapse(2,NULL,newExpressionStmt(top[-2].expr));
+            break;
+        case P_if_statement_0:
+            collapse(6,NULL,newIfStmt(top[-4].expr,top[-2].stmt,top[-1].stmt));
+            break;
+        case P_print_statement_0:
+            collapse(3,NULL,newPrintStmt(top[-2].expr));
+            break;
+        case P_while_statement_0:
+            collapse(5,NULL,newWhileStmt(top[-3].expr,top[-1].stmt));
+            break;
+        case P_assignment_0:{
+            // top[-1] holds the value after '=' together with the '=' token.
+            Expr* value = top[-1].expr;
+            ll1.valueCount--;
+            if(value == NULL)break;
+            if(!top[-2].target){
+                errorAt(&top[-1].token, "Invalid assignment target.", NULL);
+                freeExpr(value);
+                break;
+            }
+            Expr* target = top[-2].expr;
+            top[-2].expr = newAssign(target->as.variable.name,value);
+            top[-2].target = false;
+            freeExpr(target);
+            break;
+        }
+        case P_assignment_opt1_0:
+            top[-2].expr = top[-1].expr;
+            ll1.valueCount--;
+            break;
+        case P_equality_rep1_0:
+        case P_comparison_rep1_0:
+        case P_term_rep1_0:
+        case P_factor_rep1_0:
+            collapse(3,newBinary(top[-3].expr,top[-2].token,top[-1].expr),NULL);
+            break;
+        case P_unary_0:
+            collapse(2,newUnary(top[-2].token,top[-1].expr),NULL);
+            break;
+        case P_primary_0:
+            top[-1].expr = newLiteral(strtol(top[-1].token.start, NULL, 10));
+            break;
+        case P_primary_1:
+            top[-1].expr = newVariable(top[-1].token);
+            top[-1].target = true;
+            break;
+        case P_primary_2:
+            collapse(3,top[-2].expr,NULL);
+            break;
+        default:
+            break;
+    }
+}
+
+// Frees the nodes still on the value stack after an error.
+static void discardValues(){
+    for(int i = 0;i<ll1.valueCount;i++){
+        freeExpr(ll1.values[i].expr);
+        freeStmt(ll1.values[i].stmt);
+    }
+    ll1.valueCount = 0;
+}
+
+//============ PUBLIC INTERFACE ==================
+
+Stmt** ll1_parse(const char* source,int* count){
+    lexer_init(&ll1.lexer,source);
+    ll1.hadError = false;
+    ll1.statements = NULL;
+    ll1.count = 0;
+    ll1.capacity = 0;
+    ll1.valueCount = 0;
+
+    if(ll1.symbolCapacity < 64){
+        ll1.symbolCapacity = 64;
+        ll1.symbols = realloc(ll1.symbols, sizeof(short) * ll1.symbolCapacity);
+    }
+    // The parse stack lives in locals while the loop runs; only reduce()
+    // and advance() touch the parser state.
+    short* symbols = ll1.symbols;
+    int depth = 0;
+    symbols[depth++] = TOKEN_EOF;
+    symbols[depth++] = LL1_START;
+    advance();
+
+    while(depth > 0 && !ll1.hadError){
+        int symbol = symbols[--depth];
+        if(symbol < LL1_NONTERMINAL){
+            if((int)ll1.current.type != symbol){
+                errorAt(&ll1.current, "Expect %s.", ll1TokenNames[symbol]);
+                break;
+            }
+            pushValue(ll1.current,NULL,NULL);
+            if(symbol != TOKEN_EOF)advance();
+        }else if(symbol < LL1_ACTION){
+            int nonterminal = symbol - LL1_NONTERMINAL;
+            int predicted = ll1Table[nonterminal][ll1Column[ll1.current.type]];
+            if(predicted == 0){
+                errorAt(&ll1.current, "Expect %s.", ll1RuleNames[nonterminal]);
+                break;
+            }
+            const LL1Production* production = &ll1Productions[predicted - 1];
+            if(depth + production->length > ll1.symbolCapacity){
+                ll1.symbolCapacity *= 2;
+                ll1.symbols = symbols = realloc(symbols, sizeof(short) * ll1.symbolCapacity);
+            }
+            const short* rhs = ll1Symbols + production->start;
+            for(int i = production->length - 1;i >= 0;i--)symbols[depth++] = rhs[i];
+        }else{
+            reduce(symbol - LL1_ACTION);
+        }
+    }
+
+    discardValues();
+    *count = ll1.count;
+    return ll1.statements;
+}
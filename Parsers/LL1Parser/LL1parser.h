@@ -0,0 +1,41 @@
+#ifndef LL1PARSER_HEADER_H
+#define LL1PARSER_HEADER_H
+#include "stdbool.h"
+#include "../../Lexer/lexer.h"
+#include "../RecursiveDescentParser/AST.h"
+
+// One entry of the value stack: the token a terminal matched, or the node
+// a production built. `target` marks a bare variable, the only thing an
+// assignment may write to.
+typedef struct{
+    Token token;
+    Expr* expr;
+    Stmt* stmt;
+    bool target;
+}LL1Value;
+
+// Table-driven parser for the grammar in BNFgrammar.md. The parse and value
+// stacks are explicit arrays kept between calls, so parsing never recurses
+// and, once they have grown, never reallocates them.
+typedef struct{
+    Lexer lexer;
+    Token current;
+    short* symbols;
+    int symbolCapacity;
+    LL1Value* values;
+    int valueCount;
+    int valueCapacity;
+    Stmt** statements;
+    int count;
+    int capacity;
+    bool hadError;
+}LL1Parser;
+
+extern LL1Parser ll1;
+
+// Same contract as parse(): returns the statements read before the first
+// error, with ll1.hadError set if there was one. The trees are identical
+// to the ones the recursive descent parser builds.
+Stmt** ll1_parse(const char* source, int* count);
+
+#endif
@@ -0,0 +1,458 @@
+// Generated by Parsers/LL1Parser/generator.c from BNFgrammar.md. Do not edit.
+#ifndef LL1TABLE_HEADER_H
+#define LL1TABLE_HEADER_H
+#include "../../Lexer/lexer.h"
+
+// Productions, with the semantic actions LL1parser.c runs:
+//   P_program_0              program ::= program_rep1
+//   P_program_rep1_0         program_rep1 ::= declaration {build} program_rep1
+//   P_program_rep1_1         program_rep1 ::=
+//   P_declaration_0          declaration ::= var_declaration
+//   P_declaration_1          declaration ::= statement
+//   P_statement_0            statement ::= expr_statement
+//   P_statement_1            statement ::= if_statement
+//   P_statement_2            statement ::= print_statement
+//   P_statement_3            statement ::= while_statement
+//   P_var_declaration_0      var_declaration ::= int IDENTIFIER var_declaration_opt1 ; {build}
+//   P_var_declaration_opt1_0 var_declaration_opt1 ::= = expression {build}
+//   P_var_declaration_opt1_1 var_declaration_opt1 ::= {empty}
+//   P_expr_statement_0       expr_statement ::= expression ; {build}
+//   P_if_statement_0         if_statement ::= if ( expression ) statement if_statement_opt1 {build}
+//   P_if_statement_opt1_0    if_statement_opt1 ::= else statement {build}
+//   P_if_statement_opt1_1    if_statement_opt1 ::= {empty}
+//   P_print_statement_0      print_statement ::= print expression ; {build}
+//   P_while_statement_0      while_statement ::= while ( expression ) statement {build}
+//   P_expression_0           expression ::= assignment
+//   P_assignment_0           assignment ::= equality assignment_opt1 {build}
+//   P_assignment_opt1_0      assignment_opt1 ::= = assignment {build}
+//   P_assignment_opt1_1      assignment_opt1 ::= {empty}
+//   P_equality_0             equality ::= comparison equality_rep1
+//   P_equality_rep1_0        equality_rep1 ::= equality_grp1 comparison {build} equality_rep1
+//   P_equality_grp1_0        equality_grp1 ::= !=
+//   P_equality_grp1_1        equality_grp1 ::= ==
+//   P_equality_rep1_1        equality_rep1 ::=
+//   P_comparison_0           comparison ::= term comparison_rep1
+//   P_comparison_rep1_0      comparison_rep1 ::= comparison_grp1 term {build} comparison_rep1
+//   P_comparison_grp1_0      comparison_grp1 ::= >
+//   P_comparison_grp1_1      comparison_grp1 ::= >=
+//   P_comparison_grp1_2      comparison_grp1 ::= <
+//   P_comparison_grp1_3      comparison_grp1 ::= <=
+//   P_comparison_rep1_1      comparison_rep1 ::=
+//   P_term_0                 term ::= factor term_rep1
+//   P_term_rep1_0            term_rep1 ::= term_grp1 factor {build} term_rep1
+//   P_term_grp1_0            term_grp1 ::= -
+//   P_term_grp1_1            term_grp1 ::= +
+//   P_term_rep1_1            term_rep1 ::=
+//   P_factor_0               factor ::= unary factor_rep1
+//   P_factor_rep1_0          factor_rep1 ::= factor_grp1 unary {build} factor_rep1
+//   P_factor_grp1_0          factor_grp1 ::= /
+//   P_factor_grp1_1          factor_grp1 ::= *
+//   P_factor_rep1_1          factor_rep1 ::=
+//   P_unary_0                unary ::= unary_grp1 unary {build}
+//   P_unary_grp1_0           unary_grp1 ::= -
+//   P_unary_grp1_1           unary_grp1 ::= +
+//   P_unary_grp1_2           unary_grp1 ::= !
+//   P_unary_1                unary ::= primary
+//   P_primary_0              primary ::= INTEGER_LITERAL {build}
+//   P_primary_1              primary ::= IDENTIFIER {build}
+//   P_primary_2              primary ::= ( expression ) {build}
+//
+// FIRST / FOLLOW:
+//   program              first: int IDENTIFIER if ( print while - + ! INTEGER_LITERAL <empty>
+//                        follow: end
+//   declaration          first: int IDENTIFIER if ( print while - + ! INTEGER_LITERAL
+//                        follow: end int IDENTIFIER if ( print while - + ! INTEGER_LITERAL
+//   statement            first: IDENTIFIER if ( print while - + ! INTEGER_LITERAL
+//                        follow: end int IDENTIFIER if ( else print while - + ! INTEGER_LITERAL
+//   var_declaration      first: int
+//                        follow: end int IDENTIFIER if ( print while - + ! INTEGER_LITERAL
+//   expr_statement       first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: end int IDENTIFIER if ( else print while - + ! INTEGER_LITERAL
+//   if_statement         first: if
+//                        follow: end int IDENTIFIER if ( else print while - + ! INTEGER_LITERAL
+//   print_statement      first: print
+//                        follow: end int IDENTIFIER if ( else print while - + ! INTEGER_LITERAL
+//   while_statement      first: while
+//                        follow: end int IDENTIFIER if ( else print while - + ! INTEGER_LITERAL
+//   expression           first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: ; )
+//   assignment           first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: ; )
+//   equality             first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: = ; )
+//   comparison           first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: = ; ) != ==
+//   term                 first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: = ; ) != == > >= < <=
+//   factor               first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: = ; ) != == > >= < <= - +
+//   unary                first: IDENTIFIER ( - + ! INTEGER_LITERAL
+//                        follow: = ; ) != == > >= < <= - + / *
+//   primary              first: IDENTIFIER ( INTEGER_LITERAL
+//                        follow: = ; ) != == > >= < <= - + / *
+//   program_rep1         first: int IDENTIFIER if ( print while - + ! INTEGER_LITERAL <empty>
+//                        follow: end
+//   var_declaration_opt1 first: = <empty>
+//                        follow: ;
+//   if_statement_opt1    first: else <empty>
+//                        follow: end int IDENTIFIER if ( else print while - + ! INTEGER_LITERAL
+//   assignment_opt1      first: = <empty>
+//                        follow: ; )
+//   equality_rep1        first: != == <empty>
+//                        follow: = ; )
+//   equality_grp1        first: != ==
+//                        follow: IDENTIFIER ( - + ! INTEGER_LITERAL
+//   comparison_rep1      first: > >= < <= <empty>
+//                        follow: = ; ) != ==
+//   comparison_grp1      first: > >= < <=
+//                        follow: IDENTIFIER ( - + ! INTEGER_LITERAL
+//   term_rep1            first: - + <empty>
+//                        follow: = ; ) != == > >= < <=
+//   term_grp1            first: - +
+//                        follow: IDENTIFIER ( - + ! INTEGER_LITERAL
+//   factor_rep1          first: / * <empty>
+//                        follow: = ; ) != == > >= < <= - +
+//   factor_grp1          first: / *
+//                        follow: IDENTIFIER ( - + ! INTEGER_LITERAL
+//   unary_grp1           first: - + !
+//                        follow: IDENTIFIER ( - + ! INTEGER_LITERAL
+
+// Symbols on the parse stack: terminals are token types, nonterminals and
+// actions are offset so the three ranges never overlap.
+#define LL1_NONTERMINAL 64
+#define LL1_ACTION 128
+#define LL1_START (LL1_NONTERMINAL + NT_program)
+_Static_assert(TOKEN_COUNT <= LL1_NONTERMINAL, "token types overlap nonterminals");
+
+enum{
+    NT_program,
+    NT_declaration,
+    NT_statement,
+    NT_var_declaration,
+    NT_expr_statement,
+    NT_if_statement,
+    NT_print_statement,
+    NT_while_statement,
+    NT_expression,
+    NT_assignment,
+    NT_equality,
+    NT_comparison,
+    NT_term,
+    NT_factor,
+    NT_unary,
+    NT_primary,
+    NT_program_rep1,
+    NT_var_declaration_opt1,
+    NT_if_statement_opt1,
+    NT_assignment_opt1,
+    NT_equality_rep1,
+    NT_equality_grp1,
+    NT_comparison_rep1,
+    NT_comparison_grp1,
+    NT_term_rep1,
+    NT_term_grp1,
+    NT_factor_rep1,
+    NT_factor_grp1,
+    NT_unary_grp1,
+    NT_COUNT
+};
+
+enum{
+    P_program_0,
+    P_program_rep1_0,
+    P_program_rep1_1,
+    P_declaration_0,
+    P_declaration_1,
+    P_statement_0,
+    P_statement_1,
+    P_statement_2,
+    P_statement_3,
+    P_var_declaration_0,
+    P_var_declaration_opt1_0,
+    P_var_declaration_opt1_1,
+    P_expr_statement_0,
+    P_if_statement_0,
+    P_if_statement_opt1_0,
+    P_if_statement_opt1_1,
+    P_print_statement_0,
+    P_while_statement_0,
+    P_expression_0,
+    P_assignment_0,
+    P_assignment_opt1_0,
+    P_assignment_opt1_1,
+    P_equality_0,
+    P_equality_rep1_0,
+    P_equality_grp1_0,
+    P_equality_grp1_1,
+    P_equality_rep1_1,
+    P_comparison_0,
+    P_comparison_rep1_0,
+    P_comparison_grp1_0,
+    P_comparison_grp1_1,
+    P_comparison_grp1_2,
+    P_comparison_grp1_3,
+    P_comparison_rep1_1,
+    P_term_0,
+    P_term_rep1_0,
+    P_term_grp1_0,
+    P_term_grp1_1,
+    P_term_rep1_1,
+    P_factor_0,
+    P_factor_rep1_0,
+    P_factor_grp1_0,
+    P_factor_grp1_1,
+    P_factor_rep1_1,
+    P_unary_0,
+    P_unary_grp1_0,
+    P_unary_grp1_1,
+    P_unary_grp1_2,
+    P_unary_1,
+    P_primary_0,
+    P_primary_1,
+    P_primary_2,
+    P_COUNT
+};
+
+enum{ LL1_KEEP, LL1_EMPTY, LL1_BUILD };
+
+typedef struct{
+    short start;
+    unsigned char length;
+    unsigned char action;
+}LL1Production;
+
+// Right-hand sides in order, with the action marker already in place.
+static const short ll1Symbols[] = {
+    /* P_program_0 */ LL1_NONTERMINAL + NT_program_rep1,
+    /* P_program_rep1_0 */ LL1_NONTERMINAL + NT_declaration, LL1_ACTION + P_program_rep1_0, LL1_NONTERMINAL + NT_program_rep1,
+    /* P_program_rep1_1 */
+    /* P_declaration_0 */ LL1_NONTERMINAL + NT_var_declaration,
+    /* P_declaration_1 */ LL1_NONTERMINAL + NT_statement,
+    /* P_statement_0 */ LL1_NONTERMINAL + NT_expr_statement,
+    /* P_statement_1 */ LL1_NONTERMINAL + NT_if_statement,
+    /* P_statement_2 */ LL1_NONTERMINAL + NT_print_statement,
+    /* P_statement_3 */ LL1_NONTERMINAL + NT_while_statement,
+    /* P_var_declaration_0 */ TOKEN_INT, TOKEN_IDENTIFIER, LL1_NONTERMINAL + NT_var_declaration_opt1, TOKEN_SEMICOLON, LL1_ACTION + P_var_declaration_0,
+    /* P_var_declaration_opt1_0 */ TOKEN_EQUAL, LL1_NONTERMINAL + NT_expression, LL1_ACTION + P_var_declaration_opt1_0,
+    /* P_var_declaration_opt1_1 */ LL1_ACTION + P_var_declaration_opt1_1,
+    /* P_expr_statement_0 */ LL1_NONTERMINAL + NT_expression, TOKEN_SEMICOLON, LL1_ACTION + P_expr_statement_0,
+    /* P_if_statement_0 */ TOKEN_IF, TOKEN_OPEN_PARENTHESIS, LL1_NONTERMINAL + NT_expression, TOKEN_CLOSE_PARENTHESIS, LL1_NONTERMINAL + NT_statement, LL1_NONTERMINAL + NT_if_statement_opt1, LL1_ACTION + P_if_statement_0,
+    /* P_if_statement_opt1_0 */ TOKEN_ELSE, LL1_NONTERMINAL + NT_statement, LL1_ACTION + P_if_statement_opt1_0,
+    /* P_if_statement_opt1_1 */ LL1_ACTION + P_if_statement_opt1_1,
+    /* P_print_statement_0 */ TOKEN_PRINT, LL1_NONTERMINAL + NT_expression, TOKEN_SEMICOLON, LL1_ACTION + P_print_statement_0,
+    /* P_while_statement_0 */ TOKEN_WHILE, TOKEN_OPEN_PARENTHESIS, LL1_NONTERMINAL + NT_expression, TOKEN_CLOSE_PARENTHESIS, LL1_NONTERMINAL + NT_statement, LL1_ACTION + P_while_statement_0,
+    /* P_expression_0 */ LL1_NONTERMINAL + NT_assignment,
+    /* P_assignment_0 */ LL1_NONTERMINAL + NT_equality, LL1_NONTERMINAL + NT_assignment_opt1, LL1_ACTION + P_assignment_0,
+    /* P_assignment_opt1_0 */ TOKEN_EQUAL, LL1_NONTERMINAL + NT_assignment, LL1_ACTION + P_assignment_opt1_0,
+    /* P_assignment_opt1_1 */ LL1_ACTION + P_assignment_opt1_1,
+    /* P_equality_0 */ LL1_NONTERMINAL + NT_comparison, LL1_NONTERMINAL + NT_equality_rep1,
+    /* P_equality_rep1_0 */ LL1_NONTERMINAL + NT_equality_grp1, LL1_NONTERMINAL + NT_comparison, LL1_ACTION + P_equality_rep1_0, LL1_NONTERMINAL + NT_equality_rep1,
+    /* P_equality_grp1_0 */ TOKEN_BANG_EQUAL,
+    /* P_equality_grp1_1 */ TOKEN_EQUAL_EQUAL,
+    /* P_equality_rep1_1 */
+    /* P_comparison_0 */ LL1_NONTERMINAL + NT_term, LL1_NONTERMINAL + NT_comparison_rep1,
+    /* P_comparison_rep1_0 */ LL1_NONTERMINAL + NT_comparison_grp1, LL1_NONTERMINAL + NT_term, LL1_ACTION + P_comparison_rep1_0, LL1_NONTERMINAL + NT_comparison_rep1,
+    /* P_comparison_grp1_0 */ TOKEN_GREATER,
+    /* P_comparison_grp1_1 */ TOKEN_GREATER_EQUAL,
+    /* P_comparison_grp1_2 */ TOKEN_SMALLER,
+    /* P_comparison_grp1_3 */ TOKEN_SMALLER_EQUAL,
+    /* P_comparison_rep1_1 */
+    /* P_term_0 */ LL1_NONTERMINAL + NT_factor, LL1_NONTERMINAL + NT_term_rep1,
+    /* P_term_rep1_0 */ LL1_NONTERMINAL + NT_term_grp1, LL1_NONTERMINAL + NT_factor, LL1_ACTION + P_term_rep1_0, LL1_NONTERMINAL + NT_term_rep1,
+    /* P_term_grp1_0 */ TOKEN_MINUS,
+    /* P_term_grp1_1 */ TOKEN_PLUS,
+    /* P_term_rep1_1 */
+    /* P_factor_0 */ LL1_NONTERMINAL + NT_unary, LL1_NONTERMINAL + NT_factor_rep1,
+    /* P_factor_rep1_0 */ LL1_NONTERMINAL + NT_factor_grp1, LL1_NONTERMINAL + NT_unary, LL1_ACTION + P_factor_rep1_0, LL1_NONTERMINAL + NT_factor_rep1,
+    /* P_factor_grp1_0 */ TOKEN_SLASH,
+    /* P_factor_grp1_1 */ TOKEN_STAR,
+    /* P_factor_rep1_1 */
+    /* P_unary_0 */ LL1_NONTERMINAL + NT_unary_grp1, LL1_NONTERMINAL + NT_unary, LL1_ACTION + P_unary_0,
+    /* P_unary_grp1_0 */ TOKEN_MINUS,
+    /* P_unary_grp1_1 */ TOKEN_PLUS,
+    /* P_unary_grp1_2 */ TOKEN_BANG,
+    /* P_unary_1 */ LL1_NONTERMINAL + NT_primary,
+    /* P_primary_0 */ TOKEN_INTEGER, LL1_ACTION + P_primary_0,
+    /* P_primary_1 */ TOKEN_IDENTIFIER, LL1_ACTION + P_primary_1,
+    /* P_primary_2 */ TOKEN_OPEN_PARENTHESIS, LL1_NONTERMINAL + NT_expression, TOKEN_CLOSE_PARENTHESIS, LL1_ACTION + P_primary_2,
+    0
+};
+
+static const LL1Production ll1Productions[P_COUNT] = {
+    {0, 1, LL1_KEEP},
+    {1, 3, LL1_BUILD},
+    {4, 0, LL1_KEEP},
+    {4, 1, LL1_KEEP},
+    {5, 1, LL1_KEEP},
+    {6, 1, LL1_KEEP},
+    {7, 1, LL1_KEEP},
+    {8, 1, LL1_KEEP},
+    {9, 1, LL1_KEEP},
+    {10, 5, LL1_BUILD},
+    {15, 3, LL1_BUILD},
+    {18, 1, LL1_EMPTY},
+    {19, 3, LL1_BUILD},
+    {22, 7, LL1_BUILD},
+    {29, 3, LL1_BUILD},
+    {32, 1, LL1_EMPTY},
+    {33, 4, LL1_BUILD},
+    {37, 6, LL1_BUILD},
+    {43, 1, LL1_KEEP},
+    {44, 3, LL1_BUILD},
+    {47, 3, LL1_BUILD},
+    {50, 1, LL1_EMPTY},
+    {51, 2, LL1_KEEP},
+    {53, 4, LL1_BUILD},
+    {57, 1, LL1_KEEP},
+    {58, 1, LL1_KEEP},
+    {59, 0, LL1_KEEP},
+    {59, 2, LL1_KEEP},
+    {61, 4, LL1_BUILD},
+    {65, 1, LL1_KEEP},
+    {66, 1, LL1_KEEP},
+    {67, 1, LL1_KEEP},
+    {68, 1, LL1_KEEP},
+    {69, 0, LL1_KEEP},
+    {69, 2, LL1_KEEP},
+    {71, 4, LL1_BUILD},
+    {75, 1, LL1_KEEP},
+    {76, 1, LL1_KEEP},
+    {77, 0, LL1_KEEP},
+    {77, 2, LL1_KEEP},
+    {79, 4, LL1_BUILD},
+    {83, 1, LL1_KEEP},
+    {84, 1, LL1_KEEP},
+    {85, 0, LL1_KEEP},
+    {85, 3, LL1_BUILD},
+    {88, 1, LL1_KEEP},
+    {89, 1, LL1_KEEP},
+    {90, 1, LL1_KEEP},
+    {91, 1, LL1_KEEP},
+    {92, 2, LL1_BUILD},
+    {94, 2, LL1_BUILD},
+    {96, 4, LL1_BUILD},
+};
+
+// Table column of every token type; 0 is the column of tokens the grammar
+// never uses.
+#define LL1_COLUMNS 24
+static const unsigned char ll1Column[TOKEN_COUNT] = {
+    [TOKEN_EOF] = 1,
+    [TOKEN_INT] = 2,
+    [TOKEN_IDENTIFIER] = 3,
+    [TOKEN_EQUAL] = 4,
+    [TOKEN_SEMICOLON] = 5,
+    [TOKEN_IF] = 6,
+    [TOKEN_OPEN_PARENTHESIS] = 7,
+    [TOKEN_CLOSE_PARENTHESIS] = 8,
+    [TOKEN_ELSE] = 9,
+    [TOKEN_PRINT] = 10,
+    [TOKEN_WHILE] = 11,
+    [TOKEN_BANG_EQUAL] = 12,
+    [TOKEN_EQUAL_EQUAL] = 13,
+    [TOKEN_GREATER] = 14,
+    [TOKEN_GREATER_EQUAL] = 15,
+    [TOKEN_SMALLER] = 16,
+    [TOKEN_SMALLER_EQUAL] = 17,
+    [TOKEN_MINUS] = 18,
+    [TOKEN_PLUS] = 19,
+    [TOKEN_SLASH] = 20,
+    [TOKEN_STAR] = 21,
+    [TOKEN_BANG] = 22,
+    [TOKEN_INTEGER] = 23,
+};
+
+// Production to predict plus one, 0 for a syntax error. Entries skip over
+// productions that only expand a single nonterminal.
+static const unsigned char ll1Table[NT_COUNT][LL1_COLUMNS] = {
+    /* program              */ {0,3,2,2,0,0,2,2,0,0,2,2,0,0,0,0,0,0,2,2,0,0,2,2},
+    /* declaration          */ {0,0,10,13,0,0,14,13,0,0,17,18,0,0,0,0,0,0,13,13,0,0,13,13},
+    /* statement            */ {0,0,0,13,0,0,14,13,0,0,17,18,0,0,0,0,0,0,13,13,0,0,13,13},
+    /* var_declaration      */ {0,0,10,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+    /* expr_statement       */ {0,0,0,13,0,0,0,13,0,0,0,0,0,0,0,0,0,0,13,13,0,0,13,13},
+    /* if_statement         */ {0,0,0,0,0,0,14,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},
+    /* print_statement      */ {0,0,0,0,0,0,0,0,0,0,17,0,0,0,0,0,0,0,0,0,0,0,0,0},
+    /* while_statement      */ {0,0,0,0,0,0,0,0,0,0,0,18,0,0,0,0,0,0,0,0,0,0,0,0},
+    /* expression           */ {0,0,0,20,0,0,0,20,0,0,0,0,0,0,0,0,0,0,20,20,0,0,20,20},
+    /* assignment           */ {0,0,0,20,0,0,0,20,0,0,0,0,0,0,0,0,0,0,20,20,0,0,20,20},
+    /* equality             */ {0,0,0,23,0,0,0,23,0,0,0,0,0,0,0,0,0,0,23,23,0,0,23,23},
+    /* comparison           */ {0,0,0,28,0,0,0,28,0,0,0,0,0,0,0,0,0,0,28,28,0,0,28,28},
+    /* term                 */ {0,0,0,35,0,0,0,35,0,0,0,0,0,0,0,0,0,0,35,35,0,0,35,35},
+    /* factor               */ {0,0,0,40,0,0,0,40,0,0,0,0,0,0,0,0,0,0,40,40,0,0,40,40},
+    /* unary                */ {0,0,0,51,0,0,0,52,0,0,0,0,0,0,0,0,0,0,45,45,0,0,45,50},
+    /* primary              */ {0,0,0,51,0,0,0,52,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,50},
+    /* program_rep1         */ {0,3,2,2,3,3,2,2,3,3,2,2,3,3,3,3,3,3,2,2,3,3,2,2},
+    /* var_declaration_opt1 */ {0,12,12,12,11,12,12,12,12,12,12,12,12,12,12,12,12,12,12,12,12,12,12,12},
+    /* if_statement_opt1    */ {0,16,16,16,16,16,16,16,16,15,16,16,16,16,16,16,16,16,16,16,16,16,16,16},
+    /* assignment_opt1      */ {0,22,22,22,21,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22,22},
+    /* equality_rep1        */ {0,27,27,27,27,27,27,27,27,27,27,27,24,24,27,27,27,27,27,27,27,27,27,27},
+    /* equality_grp1        */ {0,0,0,0,0,0,0,0,0,0,0,0,25,26,0,0,0,0,0,0,0,0,0,0},
+    /* comparison_rep1      */ {0,34,34,34,34,34,34,34,34,34,34,34,34,34,29,29,29,29,34,34,34,34,34,34},
+    /* comparison_grp1      */ {0,0,0,0,0,0,0,0,0,0,0,0,0,0,30,31,32,33,0,0,0,0,0,0},
+    /* term_rep1            */ {0,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,36,36,39,39,39,39},
+    /* term_grp1            */ {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,37,38,0,0,0,0},
+    /* factor_rep1          */ {0,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,41,41,44,44},
+    /* factor_grp1          */ {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,42,43,0,0},
+    /* unary_grp1           */ {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,47,0,0,48,0},
+};
+
+// For error messages: the rule a nonterminal belongs to, the lexeme of a token.
+static const char* const ll1RuleNames[NT_COUNT] = {
+    "program",
+    "declaration",
+    "statement",
+    "var_declaration",
+    "expr_statement",
+    "if_statement",
+    "print_statement",
+    "while_statement",
+    "expression",
+    "assignment",
+    "equality",
+    "comparison",
+    "term",
+    "factor",
+    "unary",
+    "primary",
+    "program",
+    "var_declaration",
+    "if_statement",
+    "assignment",
+    "equality",
+    "equality",
+    "comparison",
+    "comparison",
+    "term",
+    "term",
+    "factor",
+    "factor",
+    "unary",
+};
+
+static const char* const ll1TokenNames[TOKEN_COUNT] = {
+    [TOKEN_EOF] = "end",
+    [TOKEN_INT] = "'int'",
+    [TOKEN_IDENTIFIER] = "IDENTIFIER",
+    [TOKEN_EQUAL] = "'='",
+    [TOKEN_SEMICOLON] = "';'",
+    [TOKEN_IF] = "'if'",
+    [TOKEN_OPEN_PARENTHESIS] = "'('",
+    [TOKEN_CLOSE_PARENTHESIS] = "')'",
+    [TOKEN_ELSE] = "'else'",
+    [TOKEN_PRINT] = "'print'",
+    [TOKEN_WHILE] = "'while'",
+    [TOKEN_BANG_EQUAL] = "'!='",
+    [TOKEN_EQUAL_EQUAL] = "'=='",
+    [TOKEN_GREATER] = "'>'",
+    [TOKEN_GREATER_EQUAL] = "'>='",
+    [TOKEN_SMALLER] = "'<'",
+    [TOKEN_SMALLER_EQUAL] = "'<='",
+    [TOKEN_MINUS] = "'-'",
+    [TOKEN_PLUS] = "'+'",
+    [TOKEN_SLASH] = "'/'",
+    [TOKEN_STAR] = "'*'",
+    [TOKEN_BANG] = "'!'",
+    [TOKEN_INTEGER] = "INTEGER_LITERAL",
+};
+
+#endif
@@ -0,0 +1,623 @@
+// Build-time tool: reads the grammar in BNFgrammar.md and writes the LL(1)
+// prediction table used by LL1parser.c.
+//
+//     gcc Parsers/LL1Parser/generator.c -o generator
+//     ./generator BNFgrammar.md Parsers/LL1Parser/LL1table.h
+//
+// Rules are the "#### name ::= ..." lines of the file. Groups, "?" and "*"
+// are rewritten into helper nonterminals (name_grpN, name_optN, name_repN)
+// before FIRST and FOLLOW are computed. The only conflict it accepts is an
+// optional part that may also follow itself (the dangling else); it is
+// resolved in favour of reading the optional part, like the recursive
+// descent parser does. Any other conflict stops the generator.
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "ctype.h"
+#include "stdbool.h"
+
+#define MAX_SYMBOLS 128
+#define MAX_PRODUCTIONS 254
+#define MAX_RHS 16
+#define MAX_NAME 64
+
+typedef enum{
+    KIND_TERMINAL,
+    KIND_RULE,
+    KIND_GROUP,     // name_grpN ::= a | b            forwards the chosen value
+    KIND_OPTION,    // name_optN ::= a | <empty>      empty pushes a NULL value
+    KIND_REPEAT     // name_repN ::= a name_repN | <empty>, folds each a away
+}SymbolKind;
+
+typedef enum{
+    ACTION_KEEP,    // no action, the value on top is already the result
+    ACTION_EMPTY,   // push an empty value
+    ACTION_BUILD    // LL1parser.c builds the result
+}ActionKind;
+
+typedef struct{
+    char name[MAX_NAME];
+    SymbolKind kind;
+    const char* token;      // terminals: the token_type it matches
+    char display[MAX_NAME]; // terminals: lexeme, helpers: rule they belong to
+    int helpers[3];         // rules: helpers created so far, per kind
+}Symbol;
+
+typedef struct{
+    int lhs;
+    int rhs[MAX_RHS];
+    int length;
+    ActionKind action;
+    int actionAt;           // the action runs before rhs[actionAt]
+}Production;
+
+// Terminals the lexer produces, by lexeme or by the name the grammar uses.
+static const struct{
+    const char* lexeme;
+    const char* token;
+}tokens[] = {
+    {"(", "TOKEN_OPEN_PARENTHESIS"}, {")", "TOKEN_CLOSE_PARENTHESIS"},
+    {"{", "TOKEN_OPEN_BRACE"}, {"}", "TOKEN_CLOSE_BRACE"},
+    {"+", "TOKEN_PLUS"}, {"-", "TOKEN_MINUS"},
+    {"*", "TOKEN_STAR"}, {"/", "TOKEN_SLASH"},
+    {";", "TOKEN_SEMICOLON"},
+    {">", "TOKEN_GREATER"}, {">=", "TOKEN_GREATER_EQUAL"},
+    {"<", "TOKEN_SMALLER"}, {"<=", "TOKEN_SMALLER_EQUAL"},
+    {"!", "TOKEN_BANG"}, {"!=", "TOKEN_BANG_EQUAL"},
+    {"=", "TOKEN_EQUAL"}, {"==", "TOKEN_EQUAL_EQUAL"},
+    {"IDENTIFIER", "TOKEN_IDENTIFIER"}, {"INTEGER_LITERAL", "TOKEN_INTEGER"},
+    {"if", "TOKEN_IF"}, {"else", "TOKEN_ELSE"},
+    {"int", "TOKEN_INT"}, {"while", "TOKEN_WHILE"},
+    {"print", "TOKEN_PRINT"},
+};
+
+static Symbol symbols[MAX_SYMBOLS];
+static int symbolCount = 0;
+static Production productions[MAX_PRODUCTIONS];
+static int productionCount = 0;
+static int start = -1;
+static int eof = -1;
+
+static bool nullable[MAX_SYMBOLS];
+static bool first[MAX_SYMBOLS][MAX_SYMBOLS];
+static bool follow[MAX_SYMBOLS][MAX_SYMBOLS];
+static int table[MAX_SYMBOLS][MAX_SYMBOLS];    // production + 1, 0 = error
+static int column[MAX_SYMBOLS];                // terminal -> table column
+
+//============ HELPER FUNCTIONS ==================
+
+static void fail(const char* message, const char* detail){
+    fprintf(stderr, "generator: %s%s\n", message, detail);
+    exit(1);
+}
+
+static int addSymbol(const char* name, SymbolKind kind){
+    if(symbolCount >= MAX_SYMBOLS)fail("too many symbols at ", name);
+    Symbol* symbol = &symbols[symbolCount];
+    snprintf(symbol->name, MAX_NAME, "%s", name);
+    snprintf(symbol->display, MAX_NAME, "%s", name);
+    symbol->kind = kind;
+    symbol->token = NULL;
+    memset(symbol->helpers, 0, sizeof(symbol->helpers));
+    return symbolCount++;
+}
+
+static int findSymbol(const char* name, bool terminal){
+    for(int i = 0;i<symbolCount;i++){
+        if((symbols[i].kind == KIND_TERMINAL) == terminal && strcmp(symbols[i].name, name) == 0)return i;
+    }
+    return -1;
+}
+
+static int terminal(const char* lexeme){
+    int symbol = findSymbol(lexeme,true);
+    if(symbol >= 0)return symbol;
+    for(size_t i = 0;i<sizeof(tokens) / sizeof(tokens[0]);i++){
+        if(strcmp(tokens[i].lexeme, lexeme) == 0){
+            symbol = addSymbol(lexeme,KIND_TERMINAL);
+            symbols[symbol].token = tokens[i].token;
+            return symbol;
+        }
+    }
+    fail("no token for terminal ", lexeme);
+    return -1;
+}
+
+static int helper(int rule, SymbolKind kind){
+    static const char* suffix[] = {"grp", "opt", "rep"};
+    int which = kind - KIND_GROUP;
+    char name[MAX_NAME * 2];
+    snprintf(name, sizeof(name), "%s_%s%d", symbols[rule].name, suffix[which], ++symbols[rule].helpers[which]);
+    int symbol = addSymbol(name,kind);
+    memcpy(symbols[symbol].display, symbols[rule].display, MAX_NAME);
+    return symbol;
+}
+
+static Production* addProduction(int lhs){
+    if(productionCount >= MAX_PRODUCTIONS)fail("too many productions in ", symbols[lhs].name);
+    Production* production = &productions[productionCount++];
+    production->lhs = lhs;
+    production->length = 0;
+    return production;
+}
+
+static void append(Production* production, int symbol){
+    if(production->length >= MAX_RHS)fail("production too long in ", symbols[production->lhs].name);
+    production->rhs[production->length++] = symbol;
+}
+
+//============ READING THE GRAMMAR ===============
+// alternatives ::= sequence ( "|" sequence )*
+// sequence     ::= item*
+// item         ::= ( STRING | NAME | "(" alternatives ")" ) ( "?" | "*" )?
+
+typedef struct{
+    char text[MAX_NAME];
+    bool quoted;
+}Piece;
+
+static Piece pieces[256];
+static int pieceCount;
+static int position;
+
+static void split(const char* rhs){
+    pieceCount = 0;
+    const char* c = rhs;
+    while(*c != '\0'){
+        if(pieceCount >= 256)fail("rule too long: ", rhs);
+        Piece* piece = &pieces[pieceCount];
+        int length = 0;
+        piece->quoted = false;
+        if(isspace((unsigned char)*c)){
+            c++;
+            continue;
+        }
+        if(*c == '"'){
+            piece->quoted = true;
+            c++;
+            while(*c != '\0' && *c != '"'){
+                if(*c == '\\' && c[1] != '\0')c++;  // markdown escapes such as "\*"
+                if(length < MAX_NAME - 1)piece->text[length++] = *c;
+                c++;
+            }
+            if(*c == '"')c++;
+        }else if(isalpha((unsigned char)*c) || *c == '_'){
+            while(isalnum((unsigned char)*c) || *c == '_'){
+                if(length < MAX_NAME - 1)piece->text[length++] = *c;
+                c++;
+            }
+        }else{
+            piece->text[length++] = *c++;
+        }
+        piece->text[length] = '\0';
+        pieceCount++;
+    }
+    // The closing ';' of a rule is punctuation, not a terminal.
+    if(pieceCount > 0 && !pieces[pieceCount - 1].quoted && strcmp(pieces[pieceCount - 1].text, ";") == 0)pieceCount--;
+}
+
+static bool atPunct(const char* punct){
+    return position < pieceCount && !pieces[position].quoted && strcmp(pieces[position].text, punct) == 0;
+}
+
+static void alternatives(int rule, int lhs);
+
+// Reads a parenthesised group (or a single symbol) followed by "?" or "*"
+// into a fresh helper nonterminal.
+static int wrap(int rule, int groupStart, int groupEnd, SymbolKind kind){
+    int saved = pieceCount;
+    int savedPosition = position;
+    int symbol = helper(rule,kind);
+    pieceCount = groupEnd;
+    position = groupStart;
+    alternatives(rule,symbol);
+    pieceCount = saved;
+    position = savedPosition;
+    return symbol;
+}
+
+static void sequence(int rule, Production* production){
+    while(position < pieceCount && !atPunct("|") && !atPunct(")")){
+        int symbol = -1;
+        int itemStart = position, itemEnd;
+        bool group = atPunct("(");
+        if(group){
+            int depth = 0;
+            do{
+                if(atPunct("("))depth++;
+                else if(atPunct(")"))depth--;
+                position++;
+            }while(depth > 0 && position < pieceCount);
+            if(depth > 0)fail("unbalanced parentheses in ", symbols[rule].name);
+            itemStart++;
+            itemEnd = position - 1;
+        }else{
+            Piece* piece = &pieces[position++];
+            if(piece->quoted)symbol = terminal(piece->text);
+            else if((symbol = findSymbol(piece->text,false)) < 0)symbol = terminal(piece->text);
+            itemEnd = position;
+        }
+
+        if(atPunct("?") || atPunct("*")){
+            SymbolKind kind = atPunct("?") ? KIND_OPTION : KIND_REPEAT;
+            position++;
+            append(production,wrap(rule,itemStart,itemEnd,kind));
+        }else if(group){
+            // A plain group: inline it when it has one alternative.
+            int alternativesInGroup = 1, depth = 0;
+            for(int i = itemStart;i<itemEnd;i++){
+                if(!pieces[i].quoted && strcmp(pieces[i].text, "(") == 0)depth++;
+                else if(!pieces[i].quoted && strcmp(pieces[i].text, ")") == 0)depth--;
+                else if(depth == 0 && !pieces[i].quoted && strcmp(pieces[i].text, "|") == 0)alternativesInGroup++;
+            }
+            if(alternativesInGroup == 1){
+                int saved = pieceCount, savedPosition = position;
+                pieceCount = itemEnd;
+                position = itemStart;
+                sequence(rule,production);
+                pieceCount = saved;
+                position = savedPosition;
+            }else{
+                append(production,wrap(rule,itemStart,itemEnd,KIND_GROUP));
+            }
+        }else{
+            append(production,symbol);
+        }
+    }
+}
+
+static void alternatives(int rule, int lhs){
+    for(;;){
+        Production* production = addProduction(lhs);
+        sequence(rule,production);
+        if(symbols[lhs].kind == KIND_REPEAT)append(production,lhs);
+        if(!atPunct("|"))break;
+        position++;
+    }
+    if(position < pieceCount && !atPunct(")"))fail("unexpected text in ", symbols[rule].name);
+    if(symbols[lhs].kind == KIND_OPTION || symbols[lhs].kind == KIND_REPEAT)addProduction(lhs);
+}
+
+static void readGrammar(const char* path){
+    FILE* file = fopen(path, "r");
+    if(file == NULL)fail("could not open ", path);
+    char lines[MAX_SYMBOLS][512];
+    int lineCount = 0;
+    char line[512];
+    while(fgets(line, sizeof(line), file) != NULL){
+        char* rule = line;
+        while(*rule == '#' || *rule == ' ')rule++;
+        if(strstr(rule, "::=") == NULL)continue;
+        if(lineCount >= MAX_SYMBOLS)fail("too many rules in ", path);
+        snprintf(lines[lineCount++], 512, "%s", rule);
+    }
+    fclose(file);
+
+    // Declare every rule first so a rule can use one defined below it.
+    for(int i = 0;i<lineCount;i++){
+        char name[MAX_NAME];
+        if(sscanf(lines[i], "%63[A-Za-z0-9_]", name) != 1)fail("rule without a name: ", lines[i]);
+        if(findSymbol(name,false) >= 0)fail("rule defined twice: ", name);
+        int symbol = addSymbol(name,KIND_RULE);
+        if(start < 0)start = symbol;
+    }
+    eof = addSymbol("$",KIND_TERMINAL);
+    symbols[eof].token = "TOKEN_EOF";
+    snprintf(symbols[eof].display, MAX_NAME, "end");
+
+    for(int i = 0;i<lineCount;i++){
+        char name[MAX_NAME];
+        sscanf(lines[i], "%63[A-Za-z0-9_]", name);
+        int rule = findSymbol(name,false);
+        split(strstr(lines[i], "::=") + 3);
+        position = 0;
+        alternatives(rule,rule);
+    }
+}
+
+//============ FIRST, FOLLOW AND THE TABLE =======
+
+// FIRST of rhs[from..] into set; returns whether that suffix is nullable.
+static bool firstOf(Production* production, int from, bool* set){
+    for(int i = from;i<production->length;i++){
+        int symbol = production->rhs[i];
+        for(int t = 0;t<symbolCount;t++)if(first[symbol][t])set[t] = true;
+        if(!nullable[symbol])return false;
+    }
+    return true;
+}
+
+static void computeSets(){
+    for(int i = 0;i<symbolCount;i++)if(symbols[i].kind == KIND_TERMINAL)first[i][i] = true;
+    bool changed = true;
+    while(changed){
+        changed = false;
+        for(int p = 0;p<productionCount;p++){
+            Production* production = &productions[p];
+            bool set[MAX_SYMBOLS] = {false};
+            bool empty = firstOf(production,0,set);
+            for(int t = 0;t<symbolCount;t++){
+                if(set[t] && !first[production->lhs][t]){
+                    first[production->lhs][t] = true;
+                    changed = true;
+                }
+            }
+            if(empty && !nullable[production->lhs]){
+                nullable[production->lhs] = true;
+                changed = true;
+            }
+        }
+    }
+
+    follow[start][eof] = true;
+    changed = true;
+    while(changed){
+        changed = false;
+        for(int p = 0;p<productionCount;p++){
+            Production* production = &productions[p];
+            for(int i = 0;i<production->length;i++){
+                int symbol = production->rhs[i];
+                if(symbols[symbol].kind == KIND_TERMINAL)continue;
+                bool set[MAX_SYMBOLS] = {false};
+                if(firstOf(production,i + 1,set)){
+                    for(int t = 0;t<symbolCount;t++)if(follow[production->lhs][t])set[t] = true;
+                }
+                for(int t = 0;t<symbolCount;t++){
+                    if(set[t] && !follow[symbol][t]){
+                        follow[symbol][t] = true;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void predict(int nonterminal, int t, int p){
+    int existing = table[nonterminal][t] - 1;
+    if(existing < 0 || existing == p){
+        table[nonterminal][t] = p + 1;
+        return;
+    }
+    // Prefer reading an optional part over skipping it.
+    bool existingEmpty = productions[existing].length == 0;
+    bool newEmpty = productions[p].length == 0;
+    if(existingEmpty != newEmpty && symbols[nonterminal].kind != KIND_RULE){
+        fprintf(stderr, "generator: %s on '%s' resolved in favour of reading it\n",
+                symbols[nonterminal].name, symbols[t].display);
+        if(existingEmpty)table[nonterminal][t] = p + 1;
+        return;
+    }
+    fprintf(stderr, "generator: LL(1) conflict in %s on '%s'\n", symbols[nonterminal].name, symbols[t].display);
+    exit(1);
+}
+
+static void buildTable(){
+    for(int p = 0;p<productionCount;p++){
+        Production* production = &productions[p];
+        bool set[MAX_SYMBOLS] = {false};
+        bool empty = firstOf(production,0,set);
+        for(int t = 0;t<symbolCount;t++){
+            if(set[t] || (empty && follow[production->lhs][t]))predict(production->lhs,t,p);
+        }
+    }
+    // An optional or repeated part skips itself on any other token too. The
+    // error then shows up at the next terminal, where the message can say
+    // which token was expected.
+    for(int p = 0;p<productionCount;p++){
+        Production* production = &productions[p];
+        if(production->length != 0)continue;
+        for(int t = 0;t<symbolCount;t++){
+            if(symbols[t].kind == KIND_TERMINAL && table[production->lhs][t] == 0)table[production->lhs][t] = p + 1;
+        }
+    }
+}
+
+// Decides which productions need a semantic action and where it runs.
+// Every symbol leaves one value on the parser's value stack, except the
+// repeat helpers, whose action folds each iteration into what precedes it.
+static void placeActions(){
+    for(int p = 0;p<productionCount;p++){
+        Production* production = &productions[p];
+        SymbolKind kind = symbols[production->lhs].kind;
+        production->actionAt = production->length;
+        if(production->length == 0){
+            production->action = kind == KIND_OPTION ? ACTION_EMPTY : ACTION_KEEP;
+            continue;
+        }
+        if(kind == KIND_REPEAT){
+            production->action = ACTION_BUILD;
+            production->actionAt = production->length - 1;
+            continue;
+        }
+        int values = 0, last = -1;
+        for(int i = 0;i<production->length;i++){
+            if(symbols[production->rhs[i]].kind == KIND_REPEAT)continue;
+            values++;
+            last = production->rhs[i];
+        }
+        bool forwards = values == 0 || (values == 1 && (symbols[last].kind != KIND_TERMINAL || kind == KIND_GROUP));
+        production->action = forwards ? ACTION_KEEP : ACTION_BUILD;
+    }
+}
+
+//============ OUTPUT ============================
+
+static void printSet(FILE* out, bool* set){
+    bool firstItem = true;
+    for(int t = 0;t<symbolCount;t++){
+        if(!set[t])continue;
+        fprintf(out, "%s%s", firstItem ? "" : " ", symbols[t].display);
+        firstItem = false;
+    }
+}
+
+static void writeSymbol(FILE* out, int symbol){
+    if(symbols[symbol].kind == KIND_TERMINAL)fprintf(out, "%s", symbols[symbol].token);
+    else fprintf(out, "LL1_NONTERMINAL + NT_%s", symbols[symbol].name);
+}
+
+static void productionName(char* name, int p){
+    int alternative = 0;
+    for(int i = 0;i<p;i++)if(productions[i].lhs == productions[p].lhs)alternative++;
+    snprintf(name, MAX_NAME * 2, "P_%s_%d", symbols[productions[p].lhs].name, alternative);
+}
+
+// A production that only expands one other nonterminal (statement ::=
+// print_statement) does no work, so its table entries predict what that
+// nonterminal would on the same token, saving a step per level.
+static int skipUnits(int entry, int t){
+    while(entry > 0){
+        Production* production = &productions[entry - 1];
+        if(production->length != 1 || production->action != ACTION_KEEP)break;
+        if(symbols[production->rhs[0]].kind == KIND_TERMINAL)break;
+        entry = table[production->rhs[0]][t];
+    }
+    return entry;
+}
+
+static void writeTable(FILE* out, const char* grammarPath){
+    int nonterminals = 0, columns = 1;
+    for(int i = 0;i<symbolCount;i++){
+        if(symbols[i].kind == KIND_TERMINAL)column[i] = columns++;
+        else nonterminals++;
+    }
+    if(nonterminals > 64)fail("too many nonterminals", "");
+
+    fprintf(out, "// Generated by Parsers/LL1Parser/generator.c from %s. Do not edit.\n", grammarPath);
+    fprintf(out, "#ifndef LL1TABLE_HEADER_H\n#define LL1TABLE_HEADER_H\n#include \"../../Lexer/lexer.h\"\n\n");
+
+    fprintf(out, "// Productions, with the semantic actions LL1parser.c runs:\n");
+    for(int p = 0;p<productionCount;p++){
+        Production* production = &productions[p];
+        char name[MAX_NAME * 2];
+        productionName(name,p);
+        fprintf(out, "//   %-24s %s ::=", name, symbols[production->lhs].name);
+        for(int i = 0;i<=production->length;i++){
+            if(i == production->actionAt && production->action != ACTION_KEEP)fprintf(out, " {%s}", production->action == ACTION_EMPTY ? "empty" : "build");
+            if(i < production->length){
+                Symbol* symbol = &symbols[production->rhs[i]];
+                fprintf(out, " %s", symbol->kind == KIND_TERMINAL ? symbol->display : symbol->name);
+            }
+        }
+        fprintf(out, "\n");
+    }
+    fprintf(out, "//\n// FIRST / FOLLOW:\n");
+    for(int i = 0;i<symbolCount;i++){
+        if(symbols[i].kind == KIND_TERMINAL)continue;
+        fprintf(out, "//   %-20s first: ", symbols[i].name);
+        printSet(out,first[i]);
+        if(nullable[i])fprintf(out, " <empty>");
+        fprintf(out, "\n//   %-20s follow: ", "");
+        printSet(out,follow[i]);
+        fprintf(out, "\n");
+    }
+
+    fprintf(out, "\n// Symbols on the parse stack: terminals are token types, nonterminals and\n");
+    fprintf(out, "// actions are offset so the three ranges never overlap.\n");
+    fprintf(out, "#define LL1_NONTERMINAL 64\n#define LL1_ACTION 128\n");
+    fprintf(out, "#define LL1_START (LL1_NONTERMINAL + NT_%s)\n", symbols[start].name);
+    fprintf(out, "_Static_assert(TOKEN_COUNT <= LL1_NONTERMINAL, \"token types overlap nonterminals\");\n\n");
+
+    fprintf(out, "enum{\n");
+    for(int i = 0;i<symbolCount;i++)if(symbols[i].kind != KIND_TERMINAL)fprintf(out, "    NT_%s,\n", symbols[i].name);
+    fprintf(out, "    NT_COUNT\n};\n\nenum{\n");
+    for(int p = 0;p<productionCount;p++){
+        char name[MAX_NAME * 2];
+        productionName(name,p);
+        fprintf(out, "    %s,\n", name);
+    }
+    fprintf(out, "    P_COUNT\n};\n\n");
+
+    fprintf(out, "enum{ LL1_KEEP, LL1_EMPTY, LL1_BUILD };\n\n");
+    fprintf(out, "typedef struct{\n    short start;\n    unsigned char length;\n    unsigned char action;\n}LL1Production;\n\n");
+
+    fprintf(out, "// Right-hand sides in order, with the action marker already in place.\n");
+    fprintf(out, "static const short ll1Symbols[] = {\n");
+    int offset = 0;
+    int starts[MAX_PRODUCTIONS], lengths[MAX_PRODUCTIONS];
+    for(int p = 0;p<productionCount;p++){
+        Production* production = &productions[p];
+        char name[MAX_NAME * 2];
+        productionName(name,p);
+        starts[p] = offset;
+        lengths[p] = 0;
+        fprintf(out, "    /* %s */", name);
+        for(int i = 0;i<=production->length;i++){
+            if(i == production->actionAt && production->action != ACTION_KEEP){
+                fprintf(out, " LL1_ACTION + %s,", name);
+                lengths[p]++;
+            }
+            if(i < production->length){
+                fprintf(out, " ");
+                writeSymbol(out,production->rhs[i]);
+                fprintf(out, ",");
+                lengths[p]++;
+            }
+        }
+        offset += lengths[p];
+        fprintf(out, "\n");
+    }
+    fprintf(out, "    0\n};\n\n");
+
+    static const char* actionNames[] = {"LL1_KEEP", "LL1_EMPTY", "LL1_BUILD"};
+    fprintf(out, "static const LL1Production ll1Productions[P_COUNT] = {\n");
+    for(int p = 0;p<productionCount;p++){
+        fprintf(out, "    {%d, %d, %s},\n", starts[p], lengths[p], actionNames[productions[p].action]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Table column of every token type; 0 is the column of tokens the grammar\n// never uses.\n");
+    fprintf(out, "#define LL1_COLUMNS %d\n", columns);
+    fprintf(out, "static const unsigned char ll1Column[TOKEN_COUNT] = {\n");
+    for(int i = 0;i<symbolCount;i++){
+        if(symbols[i].kind == KIND_TERMINAL)fprintf(out, "    [%s] = %d,\n", symbols[i].token, column[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Production to predict plus one, 0 for a syntax error. Entries skip over\n// productions that only expand a single nonterminal.\n");
+    fprintf(out, "static const unsigned char ll1Table[NT_COUNT][LL1_COLUMNS] = {\n");
+    for(int i = 0;i<symbolCount;i++){
+        if(symbols[i].kind == KIND_TERMINAL)continue;
+        int row[MAX_SYMBOLS] = {0};
+        for(int t = 0;t<symbolCount;t++)if(symbols[t].kind == KIND_TERMINAL)row[column[t]] = skipUnits(table[i][t],t);
+        fprintf(out, "    /* %-20s */ {", symbols[i].name);
+        for(int c = 0;c<columns;c++)fprintf(out, "%s%d", c == 0 ? "" : ",", row[c]);
+        fprintf(out, "},\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// For error messages: the rule a nonterminal belongs to, the lexeme of a token.\n");
+    fprintf(out, "static const char* const ll1RuleNames[NT_COUNT] = {\n");
+    for(int i = 0;i<symbolCount;i++)if(symbols[i].kind != KIND_TERMINAL)fprintf(out, "    \"%s\",\n", symbols[i].display);
+    fprintf(out, "};\n\nstatic const char* const ll1TokenNames[TOKEN_COUNT] = {\n");
+    for(int i = 0;i<symbolCount;i++){
+        if(symbols[i].kind != KIND_TERMINAL)continue;
+        // Named tokens (IDENTIFIER, end) read better without quotes.
+        bool named = i == eof || isupper((unsigned char)symbols[i].display[0]);
+        fprintf(out, "    [%s] = \"%s%s%s\",\n", symbols[i].token, named ? "" : "'", symbols[i].display, named ? "" : "'");
+    }
+    fprintf(out, "};\n\n#endif\n");
+}
+
+int main(int argc, char** argv){
+    if(argc < 2){
+        fprintf(stderr, "Usage: generator grammar.md [output.h]\n");
+        return 64;
+    }
+    readGrammar(argv[1]);
+    computeSets();
+    buildTable();
+    placeActions();
+
+    FILE* out = stdout;
+    if(argc > 2 && (out = fopen(argv[2], "w")) == NULL)fail("could not write ", argv[2]);
+    writeTable(out,argv[1]);
+    if(out != stdout)fclose(out);
+
+    int nonterminals = 0;
+    for(int i = 0;i<symbolCount;i++)if(symbols[i].kind != KIND_TERMINAL)nonterminals++;
+    fprintf(stderr, "generator: %d nonterminals, %d terminals, %d productions\n",
+            nonterminals, symbolCount - nonterminals, productionCount);
+    return 0;
+}
@@ -0,0 +1,152 @@
+#include <stdlib.h>
+#include "AST.h"
+
+// =================================================================
+// ==================== CONSTRUCTORS ===============================
+// =================================================================
+
+Expr* newBinary(Expr* left, Token op, Expr* right) {
+    Expr* expr = (Expr*)malloc(sizeof(Expr));
+    expr->type = EXPR_BINARY;
+    expr->as.binary.left = left;
+    expr->as.binary.op = op;
+    expr->as.binary.right = right;
+    expr->as.binary.needsCheck = true;
+    return expr;
+}
+
+Expr* newUnary(Token op, Expr* right) {
+    Expr* expr = (Expr*)malloc(sizeof(Expr));
+    expr->type = EXPR_UNARY;
+    expr->as.unary.op = op;
+    expr->as.unary.right = right;
+    expr->as.unary.needsCheck = true;
+    return expr;
+}
+
+Expr* newLiteral(int value) {
+    Expr* expr = (Expr*)malloc(sizeof(Expr));
+    expr->type = EXPR_LITERAL;
+    expr->as.literal.value = value;
+    return expr;
+}
+
+Expr* newVariable(Token name) {
+    Expr* expr = (Expr*)malloc(sizeof(Expr));
+    expr->type = EXPR_VARIABLE;
+    expr->as.variable.name = name;
+    return expr;
+}
+
+Expr* newAssign(Token name, Expr* value) {
+    Expr* expr = (Expr*)malloc(sizeof(Expr));
+    expr->type = EXPR_ASSIGN;
+    expr->as.assign.name = name;
+    expr->as.assign.value = value;
+    return expr;
+}
+
+Stmt* newExpressionStmt(Expr* expr) {
+    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
+    stmt->type = STMT_EXPRESSION;
+    stmt->as.expression.expression = expr;
+    return stmt;
+}
+
+Stmt* newPrintStmt(Expr* expr) {
+    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
+    stmt->type = STMT_PRINT;
+    stmt->as.print.expression = expr;
+    return stmt;
+}
+
+Stmt* newVarDeclStmt(Token name, Expr* initializer) {
+    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
+    stmt->type = STMT_VAR_DECLARATION;
+    stmt->as.var.name = name;
+    stmt->as.var.initializer = initializer;
+    return stmt;
+}
+
+Stmt* newIfStmt(Expr* condition, Stmt* thenBranch, Stmt* elseBranch) {
+    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
+    stmt->type = STMT_IF;
+    stmt->as.ifStmt.condition = condition;
+    stmt->as.ifStmt.thenBranch = thenBranch;
+    stmt->as.ifStmt.elseBranch = elseBranch;
+    return stmt;
+}
+
+Stmt* newWhileStmt(Expr* condition, Stmt* body) {
+    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
+    stmt->type = STMT_WHILE;
+    stmt->as.whileStmt.condition = condition;
+    stmt->as.whileStmt.body = body;
+    return stmt;
+}
+
+// =================================================================
+// ==================== DESTRUCTORS ================================
+// =================================================================
+
+void freeExpr(Expr* expr) {
+    if (expr == NULL) return;
+    switch (expr->type) {
+        case EXPR_ASSIGN:
+            freeExpr(expr->as.assign.value);
+            break;
+        case EXPR_BINARY:
+            freeExpr(expr->as.binary.left);
+            freeExpr(expr->as.binary.right);
+            break;
+        case EXPR_GROUPING:
+            freeExpr(expr->as.grouping.expression);
+            break;
+        case EXPR_UNARY:
+            freeExpr(expr->as.unary.right);
+            break;
+        case EXPR_LITERAL:
+        case EXPR_VARIABLE:
+            break;
+    }
+    free(expr);
+}
+
+void freeStmt(Stmt* stmt) {
+    if (stmt == NULL) return;
+    switch (stmt->type) {
+        case STMT_EXPRESSION:
+            freeExpr(stmt->as.expression.expression);
+            break;
+        case STMT_IF:
+            freeExpr(stmt->as.ifStmt.condition);
+            freeStmt(stmt->as.ifStmt.thenBranch);
+            freeStmt(stmt->as.ifStmt.elseBranch);
+            break;
+        case STMT_PRINT:
+            freeExpr(stmt->as.print.expression);
+            break;
+        case STMT_VAR_DECLARATION:
+            freeExpr(stmt->as.var.initializer);
+            break;
+        case STMT_WHILE:
+            freeExpr(stmt->as.whileStmt.condition);
+            freeStmt(stmt->as.whileStmt.body);
+            break;
+        case STMT_BLOCK:
+            break;
+    }
+    free(stmt);
+}
+
+// =================================================================
+// ==================== PUBLIC INTERFACE ===========================
+// =================================================================
+
+// Frees the statements returned by parse() together with the array itself.
+void freeAst(Stmt** statements, int count) {
+    for (int i = 0; i < count; i++) {
+        freeStmt(statements[i]);
+    }
+    free(statements);
+}
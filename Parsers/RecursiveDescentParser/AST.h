@@ -1,5 +1,6 @@
 #ifndef AST_h
 #define AST_h
+#include "stdbool.h"
 #include "../../Lexer/lexer.h"
 
 typedef struct Expr Expr;
@@ -15,15 +16,19 @@ typedef enum {
 } ExprType;
 
 
+// needsCheck starts out true and is cleared by the range analysis when
+// the operation can never overflow or divide by zero.
 typedef struct {
     Expr* left;
     Token op;
     Expr* right;
+    bool needsCheck;
 } BinaryExpr;
 
 typedef struct {
     Token op;
     Expr* right;
+    bool needsCheck;
 } UnaryExpr;
 
 typedef struct {
@@ -96,6 +101,7 @@ typedef struct {
 
 struct Stmt {
     StmtType type;
+    int line;           // line the statement starts on
     union {
         ExpressionStmt expression;
         PrintStmt print;
@@ -106,6 +112,22 @@ struct Stmt {
     } as;
 };
 
+// Node constructors shared by the parsers, so every parser builds
+// exactly the same tree.
+Expr* newBinary(Expr* left, Token op, Expr* right);
+Expr* newUnary(Token op, Expr* right);
+Expr* newLiteral(int value);
+Expr* newVariable(Token name);
+Expr* newAssign(Token name, Expr* value);
+Stmt* newExpressionStmt(Expr* expr);
+Stmt* newPrintStmt(Expr* expr);
+Stmt* newVarDeclStmt(Token name, Expr* initializer);
+Stmt* newIfStmt(Expr* condition, Stmt* thenBranch, Stmt* elseBranch);
+Stmt* newWhileStmt(Expr* condition, Stmt* body);
+
 void printAst(Stmt** statements, int count);
+void freeExpr(Expr* expr);
+void freeStmt(Stmt* stmt);
+void freeAst(Stmt** statements, int count);
 
 #endif
\ No newline at end of file
@@ -1,7 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdbool.h>
-#include "ast.h"
+#include "AST.h"
 
 // =================================================================
 // ==================== FORWARD DECLARATIONS =======================
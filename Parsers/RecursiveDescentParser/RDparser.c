@@ -4,90 +4,8 @@
 #include "RDparser.h"
 #include "AST.h"
 
-//============ AST HELPER FUNCTIONS(CONSTRUCTORS) ======= 
-
-static Expr* newBinary(Expr* left, Token op, Expr* right) {
-    Expr* expr = (Expr*)malloc(sizeof(Expr));
-    expr->type = EXPR_BINARY;
-    expr->as.binary.left = left;
-    expr->as.binary.op = op;
-    expr->as.binary.right = right;
-    return expr;
-}
-
-static Expr* newUnary(Token op, Expr* right) {
-    Expr* expr = (Expr*)malloc(sizeof(Expr));
-    expr->type = EXPR_UNARY;
-    expr->as.unary.op = op;
-    expr->as.unary.right = right;
-    return expr;
-}
-
-static Expr* newLiteral(int value) {
-    Expr* expr = (Expr*)malloc(sizeof(Expr));
-    expr->type = EXPR_LITERAL;
-    expr->as.literal.value = value;
-    return expr;
-}
-
-static Expr* newVariable(Token name) {
-    Expr* expr = (Expr*)malloc(sizeof(Expr));
-    expr->type = EXPR_VARIABLE;
-    expr->as.variable.name = name;
-    return expr;
-}
-
-static Expr* newAssign(Token name, Expr* value) {
-    Expr* expr = (Expr*)malloc(sizeof(Expr));
-    expr->type = EXPR_ASSIGN;
-    expr->as.assign.name = name;
-    expr->as.assign.value = value;
-    return expr;
-}
-
-static Stmt* newExpressionStmt(Expr* expr) {
-    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
-    stmt->type = STMT_EXPRESSION;
-    stmt->as.expression.expression = expr;
-    return stmt;
-}
-
-static Stmt* newPrintStmt(Expr* expr) {
-    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
-    stmt->type = STMT_PRINT;
-    stmt->as.print.expression = expr;
-    return stmt;
-}
-
-static Stmt* newVarDeclStmt(Token name, Expr* initializer) {
-    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
-    stmt->type = STMT_VAR_DECLARATION;
-    stmt->as.var.name = name;
-    stmt->as.var.initializer = initializer;
-    return stmt;
-}
-
-static Stmt* newIfStmt(Expr* condition, Stmt* thenBranch, Stmt* elseBranch) {
-    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
-    stmt->type = STMT_IF;
-    stmt->as.ifStmt.condition = condition;
-    stmt->as.ifStmt.thenBranch = thenBranch;
-    stmt->as.ifStmt.elseBranch = elseBranch;
-    return stmt;
-}
-
-static Stmt* newWhileStmt(Expr* condition, Stmt* body) {
-    Stmt* stmt = (Stmt*)malloc(sizeof(Stmt));
-    stmt->type = STMT_WHILE;
-    stmt->as.whileStmt.condition = condition;
-    stmt->as.whileStmt.body = body;
-    return stmt;
-}
-
-
-
-
-
+Lexer lexer;
+Parser parser;
 
 //============ HELPER FUNCTIONS ==================
 
@@ -161,8 +79,12 @@ static Expr* primary();
 // }
 
 static Stmt* declaration(){
-    if(match(TOKEN_INT))return var_declaration();
+    int line = parser.current.line;
+    Stmt* stmt;
+    if(match(TOKEN_INT))stmt = var_declaration();
     else return statement();
+    stmt->line = line;
+    return stmt;
 }
 
 static Stmt* var_declaration(){
@@ -175,10 +97,14 @@ static Stmt* var_declaration(){
 }
 
 static Stmt* statement(){
-    if(match(TOKEN_WHILE))return while_statement();
-    else if(match(TOKEN_PRINT))return print_statement();
-    else if(match(TOKEN_IF))return if_statement();
-    else return expr_statement();
+    int line = parser.current.line;
+    Stmt* stmt;
+    if(match(TOKEN_WHILE))stmt = while_statement();
+    else if(match(TOKEN_PRINT))stmt = print_statement();
+    else if(match(TOKEN_IF))stmt = if_statement();
+    else stmt = expr_statement();
+    stmt->line = line;
+    return stmt;
 }
 
 static Stmt* expr_statement(){
@@ -216,16 +142,22 @@ static Expr* expression(){
 }
 
 static Expr* assignment(){
-    if (check(TOKEN_IDENTIFIER) && lexer.current[0] == '=') {
-        advance(); // Consume identifier
-        Token name = parser.previous;
-        if (match(TOKEN_EQUAL)) {
-            Expr* value = assignment();
-            return newAssign(name,value); 
-        }else return NULL;
-    } else {
-        return equality();
+    Token start = parser.current;
+    Expr* expr = equality();
+    if (!match(TOKEN_EQUAL)) return expr;
+    Token equals = parser.previous;
+    Expr* value = assignment();
+    // Only a bare identifier is a target; "(a) = 1" is rejected like "1 = 2".
+    bool target = expr != NULL && expr->type == EXPR_VARIABLE && expr->as.variable.name.start == start.start;
+    if (!target) {
+        errorAt(&equals, "Invalid assignment target.");
+        freeExpr(expr);
+        freeExpr(value);
+        return NULL;
     }
+    Expr* assign = newAssign(expr->as.variable.name,value);
+    freeExpr(expr);
+    return assign;
 }
 
 static Expr* equality(){
@@ -269,7 +201,7 @@ static Expr* factor(){
 }
 
 static Expr* unary(){
-    if(match(TOKEN_MINUS) || match(TOKEN_PLUS)){
+    if(match(TOKEN_MINUS) || match(TOKEN_PLUS) || match(TOKEN_BANG)){
         Token op = parser.previous; 
         Expr* expr = unary();
         return newUnary(op,expr);
@@ -290,7 +222,12 @@ static Expr* primary(){
 }
 
 Stmt** parse(const char* source,int* count){
+    return parse_at_line(source,1,count);
+}
+
+Stmt** parse_at_line(const char* source,int line,int* count){
     lexer_init(&lexer,source);
+    lexer.line = line;
     parser.hadError = false;
     Stmt** statements = NULL;
     *count = 0;
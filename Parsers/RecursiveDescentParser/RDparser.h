@@ -17,4 +17,8 @@ extern Parser parser;
 // It takes the source code as input and returns true if it's syntactically valid, and false otherwise.
 Stmt** parse(const char* source, int* count);
 
+// Same as parse(), numbering the source's lines from `line` on. Lets a
+// caller parse a program piece by piece with consistent line numbers.
+Stmt** parse_at_line(const char* source, int line, int* count);
+
 #endif
\ No newline at end of file
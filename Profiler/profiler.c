@@ -0,0 +1,429 @@
+// clock_gettime, sigaction and setitimer are POSIX, not ISO C.
+#define _POSIX_C_SOURCE 200809L
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "stdint.h"
+#include "time.h"
+#include "profiler.h"
+#ifdef _WIN32
+#include "windows.h"
+#else
+#include "signal.h"
+#include "sys/time.h"
+#endif
+
+#define DEFAULT_INTERVAL_MICROS 200
+
+//============ HELPER FUNCTIONS ==================
+
+// Monotonic nanoseconds: the wall clock can be stepped while a program runs.
+static long long now(){
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (long long)((double)counter.QuadPart * 1e9 / frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+static int slotOf(Profiler* profiler, Stmt* stmt){
+    uintptr_t hash = ((uintptr_t)stmt >> 4) * 2654435761u;
+    return (int)(hash & (uintptr_t)(profiler->keyCapacity - 1));
+}
+
+static int lookup(Profiler* profiler, Stmt* stmt){
+    int mask = profiler->keyCapacity - 1;
+    for(int slot = slotOf(profiler,stmt);;slot = (slot + 1) & mask){
+        if(profiler->keys[slot] == stmt)return profiler->keyIndexes[slot];
+        if(profiler->keys[slot] == NULL)return -1;
+    }
+}
+
+static void insert(Profiler* profiler, Stmt* stmt, int index){
+    int mask = profiler->keyCapacity - 1;
+    int slot = slotOf(profiler,stmt);
+    while(profiler->keys[slot] != NULL)slot = (slot + 1) & mask;
+    profiler->keys[slot] = stmt;
+    profiler->keyIndexes[slot] = index;
+}
+
+static int countStmts(Stmt* stmt, int depth, int* maxDepth){
+    if(stmt == NULL)return 0;
+    if(depth > *maxDepth)*maxDepth = depth;
+    switch(stmt->type){
+        case STMT_IF:
+            return 1 + countStmts(stmt->as.ifStmt.thenBranch,depth + 1,maxDepth)
+                     + countStmts(stmt->as.ifStmt.elseBranch,depth + 1,maxDepth);
+        case STMT_WHILE:
+            return 1 + countStmts(stmt->as.whileStmt.body,depth + 1,maxDepth);
+        default:
+            return 1;
+    }
+}
+
+// Numbers the statements in source order, parents before their children.
+static void indexStmts(Profiler* profiler, Stmt* stmt, int parent){
+    if(stmt == NULL)return;
+    int index = profiler->count++;
+    StmtProfile* record = &profiler->stmts[index];
+    record->stmt = stmt;
+    record->parent = parent;
+    record->count = 0;
+    record->nanos = 0;
+    record->instructions = 0;
+    record->samples = 0;
+    insert(profiler,stmt,index);
+    if(stmt->type == STMT_IF){
+        indexStmts(profiler,stmt->as.ifStmt.thenBranch,index);
+        indexStmts(profiler,stmt->as.ifStmt.elseBranch,index);
+    }else if(stmt->type == STMT_WHILE){
+        indexStmts(profiler,stmt->as.whileStmt.body,index);
+    }
+}
+
+static const char* kindName(Stmt* stmt){
+    switch(stmt->type){
+        case STMT_EXPRESSION:      return "expr";
+        case STMT_PRINT:           return "print";
+        case STMT_VAR_DECLARATION: return "int";
+        case STMT_IF:              return "if";
+        case STMT_WHILE:           return "while";
+        case STMT_BLOCK:           return "block";
+    }
+    return "?";
+}
+
+static long long totalSamples(Profiler* profiler){
+    long long samples = profiler->idleSamples;
+    for(int i = 0;i<profiler->count;i++)samples += profiler->stmts[i].samples;
+    return samples;
+}
+
+static long long totalInstructions(Profiler* profiler){
+    long long instructions = 0;
+    for(int i = 0;i<profiler->count;i++)instructions += profiler->stmts[i].instructions;
+    return instructions;
+}
+
+// Self time of every statement in nanoseconds: its own time minus the time
+// of the statements directly inside it. Sampled profiles split the CPU time
+// of the run by the share of samples; the kernel may deliver the timer less
+// often than asked, so the requested interval is not used as the weight.
+// Exact profiles of the VM split the run by the share of instructions.
+static long long* selfTimes(Profiler* profiler){
+    bool exact = profiler->mode == PROFILE_EXACT;
+    long long shares = exact ? totalInstructions(profiler) : totalSamples(profiler);
+    long long* self = (long long*)malloc(sizeof(long long) * (profiler->count > 0 ? profiler->count : 1));
+    for(int i = 0;i<profiler->count;i++){
+        StmtProfile* record = &profiler->stmts[i];
+        long long share = exact ? record->instructions : record->samples;
+        if(exact && profiler->vm == NULL)self[i] = record->nanos;
+        else self[i] = shares > 0 ? (long long)((double)share * profiler->runNanos / shares) : 0;
+    }
+    if(exact && profiler->vm == NULL){
+        for(int i = 0;i<profiler->count;i++){
+            int parent = profiler->stmts[i].parent;
+            if(parent >= 0)self[parent] -= profiler->stmts[i].nanos;
+        }
+    }
+    return self;
+}
+
+// Time including nested statements. Children come after their parent, so
+// one backwards pass adds every subtree into its root.
+static long long* totalTimes(Profiler* profiler, long long* self){
+    long long* total = (long long*)malloc(sizeof(long long) * (profiler->count > 0 ? profiler->count : 1));
+    memcpy(total, self, sizeof(long long) * profiler->count);
+    for(int i = profiler->count - 1;i >= 0;i--){
+        int parent = profiler->stmts[i].parent;
+        if(parent >= 0)total[parent] += total[i];
+    }
+    return total;
+}
+
+static long long sum(long long* values, int count){
+    long long result = 0;
+    for(int i = 0;i<count;i++)result += values[i];
+    return result;
+}
+
+// Adds the VM's per instruction counts to their statements.
+static void collectInstructions(Profiler* profiler){
+    if(profiler->pcCounts == NULL)return;
+    for(int pc = 0;pc<profiler->vm->chunk->count;pc++){
+        int index = profiler->pcStmts[pc];
+        long long count = profiler->pcCounts[pc];
+        if(index < 0 || count == 0)continue;
+        StmtProfile* record = &profiler->stmts[index];
+        record->instructions += count;
+        if(count > record->count)record->count = count;
+    }
+}
+
+//============ SAMPLING ==========================
+
+#ifndef _WIN32
+static Profiler* sampling = NULL;
+static struct sigaction previousAction;
+
+static long long cpuTime(){
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// The lookup only reads the table built by profiler_init, so it is safe
+// in a signal handler.
+static void onSample(int sig){
+    (void)sig;
+    Profiler* profiler = sampling;
+    if(profiler == NULL)return;
+    int index;
+    if(profiler->vm != NULL){
+        int pc = profiler->vm->currentPc;
+        index = pc >= 0 ? profiler->pcStmts[pc] : -1;
+    }else{
+        Stmt* current = profiler->current;
+        index = current != NULL ? lookup(profiler,current) : -1;
+    }
+    if(index >= 0)profiler->stmts[index].samples++;
+    else profiler->idleSamples++;
+}
+#endif
+
+void profiler_start(Profiler* profiler){
+    if(profiler->mode != PROFILE_SAMPLE){
+        profiler->runNanos = -now();
+        return;
+    }
+#ifndef _WIN32
+    sampling = profiler;
+    profiler->runNanos = -cpuTime();
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = onSample;
+    action.sa_flags = SA_RESTART;   // output writes must not fail with EINTR
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &previousAction);
+
+    struct itimerval timer;
+    timer.it_interval.tv_sec = 0;
+    timer.it_interval.tv_usec = profiler->intervalMicros;
+    timer.it_value = timer.it_interval;
+    setitimer(ITIMER_PROF, &timer, NULL);
+#else
+    fprintf(stderr, "Sampling is not supported on this platform, use the exact mode.\n");
+#endif
+}
+
+void profiler_stop(Profiler* profiler){
+    if(profiler->mode != PROFILE_SAMPLE){
+        profiler->runNanos += now();
+        collectInstructions(profiler);
+    }else{
+#ifndef _WIN32
+        struct itimerval timer;
+        memset(&timer, 0, sizeof(timer));
+        setitimer(ITIMER_PROF, &timer, NULL);
+        sigaction(SIGPROF, &previousAction, NULL);
+        sampling = NULL;
+        profiler->runNanos += cpuTime();
+#endif
+    }
+    if(profiler->vm != NULL){
+        profiler->vm->pcCounts = NULL;
+        profiler->vm->publishPc = false;
+    }
+}
+
+//============ PUBLIC INTERFACE ==================
+
+void profiler_init(Profiler* profiler, ProfileMode mode, Stmt** statements, int count){
+    int total = 0, maxDepth = 0;
+    for(int i = 0;i<count;i++)total += countStmts(statements[i],1,&maxDepth);
+
+    profiler->mode = mode;
+    profiler->stmts = (StmtProfile*)malloc(sizeof(StmtProfile) * (total > 0 ? total : 1));
+    profiler->count = 0;
+    profiler->keyCapacity = 16;
+    while(profiler->keyCapacity < total * 2)profiler->keyCapacity *= 2;
+    profiler->keys = (Stmt**)calloc(profiler->keyCapacity,sizeof(Stmt*));
+    profiler->keyIndexes = (int*)malloc(sizeof(int) * profiler->keyCapacity);
+    profiler->stack = (Stmt**)malloc(sizeof(Stmt*) * (maxDepth + 1));
+    profiler->stackIndexes = (int*)malloc(sizeof(int) * (maxDepth + 1));
+    profiler->started = (long long*)malloc(sizeof(long long) * (maxDepth + 1));
+    profiler->depth = 0;
+    profiler->current = NULL;
+    profiler->idleSamples = 0;
+    profiler->runNanos = 0;
+    profiler->intervalMicros = DEFAULT_INTERVAL_MICROS;
+    profiler->vm = NULL;
+    profiler->pcStmts = NULL;
+    profiler->pcCounts = NULL;
+    for(int i = 0;i<count;i++)indexStmts(profiler,statements[i],-1);
+}
+
+void profiler_enter(Profiler* profiler, Stmt* stmt){
+    int depth = profiler->depth++;
+    profiler->stack[depth] = stmt;
+    profiler->current = stmt;
+    if(profiler->mode == PROFILE_EXACT){
+        int index = lookup(profiler,stmt);
+        profiler->stackIndexes[depth] = index;
+        if(index >= 0)profiler->stmts[index].count++;
+        profiler->started[depth] = now();
+    }
+}
+
+void profiler_exit(Profiler* profiler){
+    int depth = --profiler->depth;
+    if(profiler->mode == PROFILE_EXACT){
+        int index = profiler->stackIndexes[depth];
+        if(index >= 0)profiler->stmts[index].nanos += now() - profiler->started[depth];
+    }
+    profiler->current = depth > 0 ? profiler->stack[depth - 1] : NULL;
+}
+
+// Maps every instruction to the outermost statement starting on its line,
+// or to the last statement starting above it when none does.
+void profiler_attach_vm(Profiler* profiler, VM* vm){
+    Chunk* chunk = vm->chunk;
+    int lines = 0;
+    for(int i = 0;i<profiler->count;i++)if(profiler->stmts[i].stmt->line > lines)lines = profiler->stmts[i].stmt->line;
+    for(int pc = 0;pc<chunk->count;pc++)if(chunk->tokens[pc].line > lines)lines = chunk->tokens[pc].line;
+    int* owners = (int*)malloc(sizeof(int) * (lines + 1));
+    for(int line = 0;line <= lines;line++)owners[line] = -1;
+    for(int i = 0;i<profiler->count;i++){
+        int line = profiler->stmts[i].stmt->line;
+        if(line >= 0 && owners[line] < 0)owners[line] = i;
+    }
+    for(int line = 1;line <= lines;line++)if(owners[line] < 0)owners[line] = owners[line - 1];
+
+    profiler->vm = vm;
+    profiler->pcStmts = (int*)malloc(sizeof(int) * (chunk->count > 0 ? chunk->count : 1));
+    for(int pc = 0;pc<chunk->count;pc++)profiler->pcStmts[pc] = -1;
+    for(int pc = 0;pc<chunk->count;pc += opcode_size(chunk->code[pc])){
+        int line = chunk->tokens[pc].line;
+        if(chunk->code[pc] != OP_RETURN && line >= 0)profiler->pcStmts[pc] = owners[line];
+    }
+    free(owners);
+
+    if(profiler->mode == PROFILE_EXACT){
+        profiler->pcCounts = (long long*)calloc(chunk->count > 0 ? chunk->count : 1,sizeof(long long));
+        vm->pcCounts = profiler->pcCounts;
+    }else vm->publishPc = true;
+}
+
+void profiler_write_hotspots(Profiler* profiler, FILE* file, int top){
+    long long* self = selfTimes(profiler);
+    long long* total = totalTimes(profiler,self);
+    long long all = sum(self,profiler->count);
+    int* order = (int*)malloc(sizeof(int) * (profiler->count > 0 ? profiler->count : 1));
+    for(int i = 0;i<profiler->count;i++)order[i] = i;
+
+    // Selection of the `top` largest self times; the list is short.
+    if(top > profiler->count)top = profiler->count;
+    for(int i = 0;i<top;i++){
+        int best = i;
+        for(int j = i + 1;j<profiler->count;j++)if(self[order[j]] > self[order[best]])best = j;
+        int swap = order[i];
+        order[i] = order[best];
+        order[best] = swap;
+    }
+
+    if(profiler->mode == PROFILE_SAMPLE){
+        fprintf(file, "%lld samples over %.3f ms of CPU time\n", totalSamples(profiler), profiler->runNanos / 1e6);
+    }else if(profiler->vm != NULL){
+        fprintf(file, "%lld instructions over %.3f ms\n", totalInstructions(profiler), profiler->runNanos / 1e6);
+    }
+    fprintf(file, "%6s %12s %12s %12s %6s  %s\n", "self%", "self ms", "total ms", "count", "line", "statement");
+    for(int i = 0;i<top;i++){
+        int index = order[i];
+        StmtProfile* record = &profiler->stmts[index];
+        char count[24] = "-";
+        if(profiler->mode == PROFILE_EXACT)snprintf(count, sizeof(count), "%lld", record->count);
+        fprintf(file, "%6.1f %12.3f %12.3f %12s %6d  %s\n",
+                all > 0 ? 100.0 * self[index] / all : 0.0, self[index] / 1e6, total[index] / 1e6,
+                count, record->stmt->line, kindName(record->stmt));
+    }
+    free(order);
+    free(total);
+    free(self);
+}
+
+void profiler_write_listing(Profiler* profiler, const char* source, FILE* file){
+    long long* self = selfTimes(profiler);
+    long long all = sum(self,profiler->count);
+    int lines = 1;
+    for(const char* c = source;*c != '\0';c++)if(*c == '\n')lines++;
+
+    // A line's count is that of its most executed statement, its time the
+    // self time of every statement starting on it.
+    long long* lineCount = (long long*)calloc(lines + 1,sizeof(long long));
+    long long* lineSelf = (long long*)calloc(lines + 1,sizeof(long long));
+    bool* hasStmt = (bool*)calloc(lines + 1,sizeof(bool));
+    for(int i = 0;i<profiler->count;i++){
+        int line = profiler->stmts[i].stmt->line;
+        if(line < 1 || line > lines)continue;
+        hasStmt[line] = true;
+        if(profiler->stmts[i].count > lineCount[line])lineCount[line] = profiler->stmts[i].count;
+        lineSelf[line] += self[i];
+    }
+
+    fprintf(file, "%12s %12s %6s | source\n", "count", "self ms", "self%");
+    const char* start = source;
+    for(int line = 1;line <= lines;line++){
+        const char* end = start;
+        while(*end != '\0' && *end != '\n')end++;
+        if(hasStmt[line]){
+            char count[24] = "-";
+            if(profiler->mode == PROFILE_EXACT)snprintf(count, sizeof(count), "%lld", lineCount[line]);
+            fprintf(file, "%12s %12.3f %6.1f | %.*s\n", count, lineSelf[line] / 1e6,
+                    all > 0 ? 100.0 * lineSelf[line] / all : 0.0, (int)(end - start), start);
+        }else{
+            fprintf(file, "%12s %12s %6s | %.*s\n", "", "", "", (int)(end - start), start);
+        }
+        if(*end == '\0')break;
+        start = end + 1;
+    }
+    free(hasStmt);
+    free(lineSelf);
+    free(lineCount);
+    free(self);
+}
+
+void profiler_write_folded(Profiler* profiler, FILE* file){
+    long long* self = selfTimes(profiler);
+    int* path = (int*)malloc(sizeof(int) * (profiler->count > 0 ? profiler->count : 1));
+    for(int i = 0;i<profiler->count;i++){
+        long long weight = profiler->mode == PROFILE_EXACT ? self[i] : profiler->stmts[i].samples;
+        if(weight <= 0)continue;
+        int length = 0;
+        for(int at = i;at >= 0;at = profiler->stmts[at].parent)path[length++] = at;
+        for(int j = length - 1;j >= 0;j--){
+            Stmt* stmt = profiler->stmts[path[j]].stmt;
+            fprintf(file, "%s%s:%d", j == length - 1 ? "" : ";", kindName(stmt), stmt->line);
+        }
+        fprintf(file, " %lld\n", weight);
+    }
+    free(path);
+    free(self);
+}
+
+void profiler_free(Profiler* profiler){
+    free(profiler->stmts);
+    free(profiler->keys);
+    free(profiler->keyIndexes);
+    free(profiler->stack);
+    free(profiler->stackIndexes);
+    free(profiler->started);
+    free(profiler->pcStmts);
+    free(profiler->pcCounts);
+    profiler->stmts = NULL;
+    profiler->count = 0;
+}
@@ -0,0 +1,87 @@
+#ifndef PROFILER_HEADER_H
+#define PROFILER_HEADER_H
+#include "stdio.h"
+#include "stdbool.h"
+#include "../Parsers/RecursiveDescentParser/AST.h"
+#include "../VM/vm.h"
+
+typedef enum{
+    PROFILE_EXACT,      // count every execution and time it
+    PROFILE_SAMPLE      // a timer interrupt notes the running statement
+}ProfileMode;
+
+typedef struct{
+    Stmt* stmt;
+    int parent;         // enclosing statement, -1 at top level
+    long long count;    // executions (exact mode only); on the VM those of
+                        // its most executed instruction
+    long long nanos;    // time inside, nested statements included (exact
+                        // mode, tree walker only)
+    long long instructions; // instructions run on its lines (exact mode, VM only)
+    long long samples;  // samples taken while it was the innermost statement
+}StmtProfile;
+
+// Per-statement profile of one program run by the tree walking interpreter
+// (see Interpreter.profiler) or by the bytecode VM (see profiler_attach_vm).
+// Statements never nest differently from how the source nests them, so one
+// record per statement holds the whole call tree.
+//
+// Sampling keeps the interpreter's cost to a pointer push per statement,
+// and the VM's to a store of pc per instruction; the signal handler looks
+// the running statement up itself.
+typedef struct{
+    ProfileMode mode;
+    StmtProfile* stmts;         // in source order, parents before children
+    int count;
+    Stmt** keys;                // Stmt* -> index, open addressing
+    int* keyIndexes;
+    int keyCapacity;
+    Stmt** stack;               // statements being executed, innermost last
+    int* stackIndexes;          // their indexes (exact mode only)
+    long long* started;         // and when they started (exact mode only)
+    int depth;
+    Stmt* volatile current;     // innermost statement, read by the sampler
+    long long idleSamples;      // samples taken outside any statement
+    long long runNanos;         // between start and stop: CPU time when
+                                // sampling, wall time when counting on the VM
+    int intervalMicros;         // requested sampling period
+
+    VM* vm;                     // set by profiler_attach_vm
+    int* pcStmts;               // statement of every instruction, -1 for none
+    long long* pcCounts;        // handed to the VM in exact mode
+}Profiler;
+
+// Indexes every statement of the program; nothing is allocated later.
+void profiler_init(Profiler* profiler, ProfileMode mode, Stmt** statements, int count);
+
+// Called by the interpreter around each statement.
+void profiler_enter(Profiler* profiler, Stmt* stmt);
+void profiler_exit(Profiler* profiler);
+
+// Profiles the VM's next run instead, which must execute a chunk compiled
+// from the statements given to profiler_init. Instructions are mapped to
+// statements by the line of their token: to the outermost statement that
+// starts on it, or to the last one starting above it. Exact mode counts
+// every instruction and splits the run's time by those counts; the
+// statements' own times are not measured.
+void profiler_attach_vm(Profiler* profiler, VM* vm);
+
+// Arm and disarm the sampling timer (SIGPROF, process CPU time). Only one
+// profiler can sample at a time. In exact mode they only time the run
+// (VM only). profiler_stop also detaches the VM.
+void profiler_start(Profiler* profiler);
+void profiler_stop(Profiler* profiler);
+
+// The `top` statements with the most time spent in themselves.
+void profiler_write_hotspots(Profiler* profiler, FILE* file, int top);
+
+// The source with each line's executions and self time in the margin.
+void profiler_write_listing(Profiler* profiler, const char* source, FILE* file);
+
+// Folded stacks ("while:3;if:4;print:5 1200") for flame graph tools. The
+// weight is self time in nanoseconds in exact mode, samples otherwise.
+void profiler_write_folded(Profiler* profiler, FILE* file);
+
+void profiler_free(Profiler* profiler);
+
+#endif
@@ -0,0 +1,205 @@
+// clock_gettime is POSIX, not ISO C.
+#define _POSIX_C_SOURCE 200809L
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
+#ifdef _WIN32
+#include "windows.h"
+#endif
+#include "repl.h"
+#include "../Parsers/RecursiveDescentParser/RDparser.h"
+#include "../VM/compiler.h"
+#include "../VM/fusion.h"
+#include "../VM/vm.h"
+
+typedef struct{
+    char** lines;       // every accepted line; tokens in the chunk point into them
+    int count;
+    int capacity;
+    int line;           // number of the line being handled
+    Chunk chunk;
+    VM vm;
+    Output out;
+    bool showTime;
+}Session;
+
+//============ HELPER FUNCTIONS ==================
+
+// Monotonic microseconds, for the :time latencies.
+static double now(){
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double)counter.QuadPart * 1e6 / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+#endif
+}
+
+// Reads one line of any length without the newline. NULL at end of input.
+static char* readLine(FILE* file){
+    int capacity = 128;
+    int length = 0;
+    char* line = (char*)malloc(capacity);
+    int ch;
+    while((ch = fgetc(file)) != EOF && ch != '\n'){
+        if(length + 1 >= capacity){
+            capacity *= 2;
+            line = (char*)realloc(line, capacity);
+        }
+        line[length++] = (char)ch;
+    }
+    if(ch == EOF && length == 0){
+        free(line);
+        return NULL;
+    }
+    line[length] = '\0';
+    return line;
+}
+
+static void keepLine(Session* session, char* line){
+    if(session->count >= session->capacity){
+        session->capacity = (session->capacity < 8) ? 8 : session->capacity * 2;
+        session->lines = realloc(session->lines, sizeof(char*) * session->capacity);
+    }
+    session->lines[session->count++] = line;
+}
+
+// Times lexing on its own: the parser scans the line again while parsing.
+static int countTokens(const char* source){
+    Lexer lex;
+    lexer_init(&lex,source);
+    int tokens = 0;
+    while(scan_token(&lex).type != TOKEN_EOF)tokens++;
+    return tokens;
+}
+
+// Slot an instruction stores to, or -1.
+static int storedSlot(const int* ins){
+    switch(ins[0]){
+        case OP_STORE:
+        case OP_INC_LOCAL:
+        case OP_INC_LOCAL_UNCHECKED:
+            return ins[1];
+        case OP_LOAD_OP_STORE:
+        case OP_LOAD_CONST_OP_STORE:
+            return ins[4];
+        default:
+            return -1;
+    }
+}
+
+// Number of the slots from `firstSlot` on whose declarations ran before
+// the instruction at `errorPc`. Declarations are top-level statements and
+// a new slot is only stored to by its declaration first, so a store that
+// comes before the error in the code has run.
+static int declaredBefore(Chunk* chunk, int codeStart, int errorPc, int firstSlot){
+    int declared = 0;
+    for(int pc = codeStart;pc<errorPc;pc += opcode_size(chunk->code[pc])){
+        int slot = storedSlot(&chunk->code[pc]);
+        if(slot >= firstSlot && slot - firstSlot + 1 > declared)declared = slot - firstSlot + 1;
+    }
+    return declared;
+}
+
+//============ LINE HANDLING =====================
+
+static void runLine(Session* session, char* line){
+    double start = now();
+    int tokens = countTokens(line);
+    double lexed = now();
+
+    int count = 0;
+    Stmt** statements = parse_at_line(line,session->line,&count);
+    double parsed = now();
+    if(parser.hadError){
+        freeAst(statements,count);
+        free(line);
+        return;
+    }
+
+    // Only the new statements are compiled, at the end of the session's code.
+    Chunk* chunk = &session->chunk;
+    int codeStart = chunk->count;
+    int slotsBefore = chunk->slotCount;
+    bool compiled = compile(chunk,statements,count);
+    freeAst(statements,count);
+    if(!compiled){
+        chunk->count = codeStart;
+        chunk->slotCount = slotsBefore;
+        free(line);
+        return;
+    }
+    fuse(chunk,codeStart);
+    keepLine(session,line);
+    double lowered = now();
+
+    if(!vm_run(&session->vm,codeStart)){
+        // Like the interpreter, keep the variables declared before the
+        // error and forget the rest. The line's code never runs again.
+        chunk->slotCount = slotsBefore + declaredBefore(chunk,codeStart,session->vm.errorPc,slotsBefore);
+        chunk->count = codeStart;
+    }
+    double ran = now();
+
+    if(session->showTime){
+        fprintf(stderr, "  lex %.2fus (%d tokens) | parse %.2fus | compile %.2fus | run %.2fus\n",
+                lexed - start, tokens, parsed - lexed, lowered - parsed, ran - lowered);
+    }
+}
+
+static bool runCommand(Session* session, const char* line){
+    if(strcmp(line, ":quit") == 0)return false;
+    if(strcmp(line, ":time") == 0){
+        session->showTime = !session->showTime;
+        fprintf(stderr, "timing %s\n", session->showTime ? "on" : "off");
+    }else if(strcmp(line, ":dump") == 0){
+        disassemble_chunk(&session->chunk,stderr);
+    }else{
+        fprintf(stderr, "Unknown command '%s'. Use :time, :dump or :quit.\n", line);
+    }
+    return true;
+}
+
+//============ PUBLIC INTERFACE ==================
+
+int repl(void){
+    Session session;
+    session.lines = NULL;
+    session.count = 0;
+    session.capacity = 0;
+    session.line = 0;
+    session.showTime = false;
+    chunk_init(&session.chunk);
+    output_init_fd(&session.out,1);
+    vm_init(&session.vm,&session.chunk,&session.out);
+
+    for(;;){
+        printf("> ");
+        fflush(stdout);
+        char* line = readLine(stdin);
+        session.line++;
+        if(line == NULL){
+            printf("\n");
+            break;
+        }
+        if(line[0] == ':'){
+            bool more = runCommand(&session,line);
+            free(line);
+            if(!more)break;
+            continue;
+        }
+        runLine(&session,line);
+    }
+
+    vm_free(&session.vm);
+    chunk_free(&session.chunk);
+    output_free(&session.out);
+    for(int i = 0;i<session.count;i++)free(session.lines[i]);
+    free(session.lines);
+    return 0;
+}
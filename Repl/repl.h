@@ -0,0 +1,14 @@
+#ifndef REPL_HEADER_H
+#define REPL_HEADER_H
+
+// Interactive session reading statements one line at a time from stdin.
+// Each line is lexed, parsed, compiled and fused on its own and appended
+// to the session's bytecode; variables and their slots persist across
+// lines and earlier lines are never recompiled.
+//
+// Commands: :time toggles per-line latency (lex, parse, compile, run),
+//           :dump disassembles the session's code, :quit ends it.
+// Returns the process exit code.
+int repl(void);
+
+#endif
@@ -0,0 +1,152 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "chunk.h"
+
+void chunk_init(Chunk* chunk){
+    chunk->code = NULL;
+    chunk->tokens = NULL;
+    chunk->count = 0;
+    chunk->capacity = 0;
+    chunk->slots = NULL;
+    chunk->slotCount = 0;
+    chunk->slotCapacity = 0;
+    chunk->maxStack = 0;
+    chunk->freeVariables = false;
+}
+
+void chunk_write(Chunk* chunk, int word, Token token){
+    if(chunk->count >= chunk->capacity){
+        chunk->capacity = (chunk->capacity < 64) ? 64 : chunk->capacity * 2;
+        chunk->code = realloc(chunk->code, sizeof(int) * chunk->capacity);
+        chunk->tokens = realloc(chunk->tokens, sizeof(Token) * chunk->capacity);
+    }
+    chunk->code[chunk->count] = word;
+    chunk->tokens[chunk->count] = token;
+    chunk->count++;
+}
+
+void chunk_free(Chunk* chunk){
+    free(chunk->code);
+    free(chunk->tokens);
+    free(chunk->slots);
+    chunk_init(chunk);
+}
+
+int chunk_find_slot(Chunk* chunk, const char* name, int length){
+    for(int i = 0;i<chunk->slotCount;i++){
+        Token* slot = &chunk->slots[i];
+        if(slot->length == length && memcmp(slot->start,name,length) == 0)return i;
+    }
+    return -1;
+}
+
+int chunk_add_slot(Chunk* chunk, Token name){
+    if(chunk->slotCount >= chunk->slotCapacity){
+        chunk->slotCapacity = (chunk->slotCapacity < 8) ? 8 : chunk->slotCapacity * 2;
+        chunk->slots = realloc(chunk->slots, sizeof(Token) * chunk->slotCapacity);
+    }
+    chunk->slots[chunk->slotCount] = name;
+    return chunk->slotCount++;
+}
+
+//============ DISASSEMBLER ======================
+
+int opcode_size(int op){
+    switch(op){
+        case OP_CONSTANT:
+        case OP_LOAD:
+        case OP_STORE:
+        case OP_JUMP:
+        case OP_JUMP_IF_FALSE:
+        case OP_PRINT_LOCAL:
+            return 2;
+        case OP_INC_LOCAL:
+        case OP_INC_LOCAL_UNCHECKED:
+            return 3;
+        case OP_LOAD_OP_STORE:
+        case OP_LOAD_CONST_OP_STORE:
+        case OP_CMP_JUMP_IF_FALSE:
+        case OP_CMP_CONST_JUMP_IF_FALSE:
+            return 5;
+        default:
+            return 1;
+    }
+}
+
+static const char* opcode_names[OP_COUNT] = {
+    "CONSTANT", "LOAD", "STORE", "POP",
+    "ADD", "SUB", "MUL", "DIV",
+    "NEGATE", "NOT",
+    "ADD_UNCHECKED", "SUB_UNCHECKED", "MUL_UNCHECKED", "DIV_UNCHECKED",
+    "NEGATE_UNCHECKED",
+    "GREATER", "GREATER_EQUAL", "LESS", "LESS_EQUAL",
+    "EQUAL", "NOT_EQUAL",
+    "PRINT", "JUMP", "JUMP_IF_FALSE", "RETURN", "UNDEFINED",
+    "INC_LOCAL", "INC_LOCAL_UNCHECKED", "LOAD_OP_STORE", "LOAD_CONST_OP_STORE",
+    "CMP_JUMP_IF_FALSE", "CMP_CONST_JUMP_IF_FALSE", "PRINT_LOCAL"
+};
+
+const char* opcode_name(int op){
+    if(op < 0 || op >= OP_COUNT)return "UNKNOWN";
+    return opcode_names[op];
+}
+
+static void printSlot(Chunk* chunk, int slot, FILE* file){
+    if(slot >= 0 && slot < chunk->slotCount){
+        fprintf(file, " %.*s", chunk->slots[slot].length, chunk->slots[slot].start);
+    }else fprintf(file, " #%d", slot);
+}
+
+void disassemble_chunk(Chunk* chunk, FILE* file){
+    for(int pc = 0;pc<chunk->count;pc += opcode_size(chunk->code[pc])){
+        int* ins = &chunk->code[pc];
+        fprintf(file, "%04d %4d %s", pc, chunk->tokens[pc].line, opcode_name(ins[0]));
+        switch(ins[0]){
+            case OP_CONSTANT:
+                fprintf(file, " %d", ins[1]);
+                break;
+            case OP_LOAD:
+            case OP_STORE:
+            case OP_PRINT_LOCAL:
+                printSlot(chunk,ins[1],file);
+                break;
+            case OP_JUMP:
+            case OP_JUMP_IF_FALSE:
+                fprintf(file, " -> %04d", ins[1]);
+                break;
+            case OP_UNDEFINED:
+                fprintf(file, " %.*s", chunk->tokens[pc].length, chunk->tokens[pc].start);
+                break;
+            case OP_INC_LOCAL:
+            case OP_INC_LOCAL_UNCHECKED:
+                printSlot(chunk,ins[1],file);
+                fprintf(file, " %d", ins[2]);
+                break;
+            case OP_LOAD_OP_STORE:
+                fprintf(file, " %s", opcode_name(ins[1]));
+                printSlot(chunk,ins[2],file);
+                printSlot(chunk,ins[3],file);
+                printSlot(chunk,ins[4],file);
+                break;
+            case OP_LOAD_CONST_OP_STORE:
+                fprintf(file, " %s", opcode_name(ins[1]));
+                printSlot(chunk,ins[2],file);
+                fprintf(file, " %d", ins[3]);
+                printSlot(chunk,ins[4],file);
+                break;
+            case OP_CMP_JUMP_IF_FALSE:
+                fprintf(file, " %s", opcode_name(ins[1]));
+                printSlot(chunk,ins[2],file);
+                printSlot(chunk,ins[3],file);
+                fprintf(file, " -> %04d", ins[4]);
+                break;
+            case OP_CMP_CONST_JUMP_IF_FALSE:
+                fprintf(file, " %s", opcode_name(ins[1]));
+                printSlot(chunk,ins[2],file);
+                fprintf(file, " %d -> %04d", ins[3], ins[4]);
+                break;
+        }
+        fprintf(file, "\n");
+    }
+}
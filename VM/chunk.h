@@ -0,0 +1,69 @@
+#ifndef CHUNK_HEADER_H
+#define CHUNK_HEADER_H
+#include "stdio.h"
+#include "stdbool.h"
+#include "../Lexer/lexer.h"
+
+// Instructions are stored as ints: an opcode followed by its operands.
+// Jump operands are absolute code offsets, variables are slot indices.
+typedef enum{
+    OP_CONSTANT,        // value
+    OP_LOAD,            // slot
+    OP_STORE,           // slot         stores the top of the stack, keeps it
+    OP_POP,
+    OP_ADD, OP_SUB,
+    OP_MUL, OP_DIV,
+    OP_NEGATE, OP_NOT,
+    // Same as above for operations the range analysis proved safe.
+    OP_ADD_UNCHECKED, OP_SUB_UNCHECKED,
+    OP_MUL_UNCHECKED, OP_DIV_UNCHECKED,
+    OP_NEGATE_UNCHECKED,
+    OP_GREATER, OP_GREATER_EQUAL,
+    OP_LESS, OP_LESS_EQUAL,
+    OP_EQUAL, OP_NOT_EQUAL,
+    OP_PRINT,
+    OP_JUMP,            // target
+    OP_JUMP_IF_FALSE,   // target       pops the condition
+    OP_RETURN,
+    OP_UNDEFINED,       //              reports its name as an undefined variable
+
+    // Superinstructions, only produced by fuse().
+    OP_INC_LOCAL,               // slot value              slot += value
+    OP_INC_LOCAL_UNCHECKED,     // slot value
+    OP_LOAD_OP_STORE,           // op a b dest             dest = a op b
+    OP_LOAD_CONST_OP_STORE,     // op a value dest         dest = a op value
+    OP_CMP_JUMP_IF_FALSE,       // cmp a b target          if !(a cmp b) jump
+    OP_CMP_CONST_JUMP_IF_FALSE, // cmp a value target      if !(a cmp value) jump
+    OP_PRINT_LOCAL,             // slot
+
+    OP_COUNT
+}opcode;
+
+typedef struct{
+    int* code;
+    Token* tokens;      // source token of every code word, for its line and
+                        // for runtime errors
+    int count;
+    int capacity;
+    Token* slots;       // variable name of every slot
+    int slotCount;
+    int slotCapacity;
+    int maxStack;       // deepest operand stack any instruction needs
+    bool freeVariables; // names the program never declares get a slot instead
+                        // of a compile error
+}Chunk;
+
+void chunk_init(Chunk* chunk);
+void chunk_write(Chunk* chunk, int word, Token token);
+void chunk_free(Chunk* chunk);
+
+// Returns the slot of name, or -1 when no such variable was declared.
+int chunk_find_slot(Chunk* chunk, const char* name, int length);
+int chunk_add_slot(Chunk* chunk, Token name);
+
+// Number of words taken by the instruction starting with op, operands included.
+int opcode_size(int op);
+const char* opcode_name(int op);
+void disassemble_chunk(Chunk* chunk, FILE* file);
+
+#endif
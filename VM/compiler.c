@@ -0,0 +1,243 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "compiler.h"
+
+typedef struct{
+    Chunk* chunk;
+    int depth;          // operand stack depth at the current instruction
+    Token token;        // last token seen, for instructions with none; its
+                        // line is moved to each statement's as it starts
+    Stmt** statements;  // the program being compiled
+    int count;
+    bool hadError;
+}Compiler;
+
+//============ HELPER FUNCTIONS ==================
+
+static void compileError(Compiler* compiler, Token* token, const char* message){
+    if(compiler->hadError)return;
+    compiler->hadError = true;
+    fprintf(stderr, "[line %d] Error at '%.*s': %s\n", token->line, token->length, token->start, message);
+}
+
+// Emits one instruction word. `effect` is the change in stack depth.
+static void emit(Compiler* compiler, int word, int effect, Token token){
+    chunk_write(compiler->chunk,word,token);
+    compiler->token = token;
+    compiler->depth += effect;
+    if(compiler->depth > compiler->chunk->maxStack)compiler->chunk->maxStack = compiler->depth;
+}
+
+static void emitOperand(Compiler* compiler, int word, Token token){
+    chunk_write(compiler->chunk,word,token);
+}
+
+// Emits a jump with a placeholder target and returns the operand's offset.
+static int emitJump(Compiler* compiler, int op, Token token){
+    emit(compiler,op,op == OP_JUMP_IF_FALSE ? -1 : 0,token);
+    emitOperand(compiler,-1,token);
+    return compiler->chunk->count - 1;
+}
+
+static void patchJump(Compiler* compiler, int operand){
+    compiler->chunk->code[operand] = compiler->chunk->count;
+}
+
+static bool declares(Stmt* stmt, Token* name){
+    if(stmt == NULL)return false;
+    switch(stmt->type){
+        case STMT_VAR_DECLARATION:{
+            Token* other = &stmt->as.var.name;
+            return other->length == name->length && memcmp(other->start,name->start,name->length) == 0;
+        }
+        case STMT_IF:
+            return declares(stmt->as.ifStmt.thenBranch,name) || declares(stmt->as.ifStmt.elseBranch,name);
+        case STMT_WHILE:
+            return declares(stmt->as.whileStmt.body,name);
+        default:
+            return false;
+    }
+}
+
+// A name without a slot is free only if the program never declares it;
+// otherwise it is being used before its declaration.
+static bool isFree(Compiler* compiler, Token* name){
+    if(!compiler->chunk->freeVariables)return false;
+    for(int i = 0;i<compiler->count;i++)if(declares(compiler->statements[i],name))return false;
+    return true;
+}
+
+// Returns -1 for a name that is not declared at this point. Using it is a
+// runtime error (OP_UNDEFINED), as in the tree walking interpreter, so a
+// branch that never runs may mention it. Programs with free variables
+// reject a use before the declaration at compile time instead.
+static int resolveSlot(Compiler* compiler, Token* name){
+    int slot = chunk_find_slot(compiler->chunk,name->start,name->length);
+    if(slot >= 0 || !compiler->chunk->freeVariables)return slot;
+    if(isFree(compiler,name))return chunk_add_slot(compiler->chunk,*name);
+    compileError(compiler,name,"Undefined variable.");
+    return slot;
+}
+
+//============ EXPRESSIONS =======================
+
+static void compileExpr(Compiler* compiler, Expr* expr);
+
+static int binaryOpcode(token_type type){
+    switch(type){
+        case TOKEN_PLUS:          return OP_ADD;
+        case TOKEN_MINUS:         return OP_SUB;
+        case TOKEN_STAR:          return OP_MUL;
+        case TOKEN_SLASH:         return OP_DIV;
+        case TOKEN_GREATER:       return OP_GREATER;
+        case TOKEN_GREATER_EQUAL: return OP_GREATER_EQUAL;
+        case TOKEN_SMALLER:       return OP_LESS;
+        case TOKEN_SMALLER_EQUAL: return OP_LESS_EQUAL;
+        case TOKEN_EQUAL_EQUAL:   return OP_EQUAL;
+        case TOKEN_BANG_EQUAL:    return OP_NOT_EQUAL;
+        default:                  return -1;
+    }
+}
+
+static void compileExpr(Compiler* compiler, Expr* expr){
+    switch(expr->type){
+        case EXPR_LITERAL:{
+            Token token = compiler->token;
+            emit(compiler,OP_CONSTANT,1,token);
+            emitOperand(compiler,expr->as.literal.value,token);
+            break;
+        }
+        case EXPR_GROUPING:
+            compileExpr(compiler,expr->as.grouping.expression);
+            break;
+        case EXPR_VARIABLE:{
+            Token* name = &expr->as.variable.name;
+            int slot = resolveSlot(compiler,name);
+            if(slot < 0){
+                emit(compiler,OP_UNDEFINED,1,*name);
+                break;
+            }
+            emit(compiler,OP_LOAD,1,*name);
+            emitOperand(compiler,slot,*name);
+            break;
+        }
+        case EXPR_ASSIGN:{
+            Token* name = &expr->as.assign.name;
+            int slot = resolveSlot(compiler,name);
+            // Like the interpreter, fail before evaluating the value.
+            if(slot < 0){
+                emit(compiler,OP_UNDEFINED,1,*name);
+                break;
+            }
+            compileExpr(compiler,expr->as.assign.value);
+            emit(compiler,OP_STORE,0,*name);
+            emitOperand(compiler,slot,*name);
+            break;
+        }
+        case EXPR_BINARY:{
+            BinaryExpr* binary = &expr->as.binary;
+            compileExpr(compiler,binary->left);
+            compileExpr(compiler,binary->right);
+            int op = binaryOpcode(binary->op.type);
+            if(op < 0){
+                compileError(compiler,&binary->op,"Unknown binary operator.");
+                return;
+            }
+            if(!binary->needsCheck && op >= OP_ADD && op <= OP_DIV)op += OP_ADD_UNCHECKED - OP_ADD;
+            emit(compiler,op,-1,binary->op);
+            break;
+        }
+        case EXPR_UNARY:{
+            UnaryExpr* unary = &expr->as.unary;
+            compileExpr(compiler,unary->right);
+            if(unary->op.type == TOKEN_MINUS)emit(compiler,unary->needsCheck ? OP_NEGATE : OP_NEGATE_UNCHECKED,0,unary->op);
+            else if(unary->op.type == TOKEN_BANG)emit(compiler,OP_NOT,0,unary->op);
+            break;
+        }
+    }
+}
+
+//============ STATEMENTS ========================
+
+static void compileStmt(Compiler* compiler, Stmt* stmt){
+    // Literals, pops and jumps belong to this statement's line, not to the
+    // line of whatever was compiled before it.
+    compiler->token.line = stmt->line;
+    switch(stmt->type){
+        case STMT_EXPRESSION:
+            compileExpr(compiler,stmt->as.expression.expression);
+            emit(compiler,OP_POP,-1,compiler->token);
+            break;
+        case STMT_PRINT:
+            compileExpr(compiler,stmt->as.print.expression);
+            emit(compiler,OP_PRINT,-1,compiler->token);
+            break;
+        case STMT_VAR_DECLARATION:{
+            Token* name = &stmt->as.var.name;
+            compiler->token = *name;
+            if(stmt->as.var.initializer != NULL)compileExpr(compiler,stmt->as.var.initializer);
+            else{
+                emit(compiler,OP_CONSTANT,1,*name);
+                emitOperand(compiler,0,*name);
+            }
+            // Declared after the initializer, like the tree walking interpreter.
+            int slot = chunk_find_slot(compiler->chunk,name->start,name->length);
+            if(slot < 0)slot = chunk_add_slot(compiler->chunk,*name);
+            emit(compiler,OP_STORE,0,*name);
+            emitOperand(compiler,slot,*name);
+            emit(compiler,OP_POP,-1,*name);
+            break;
+        }
+        case STMT_IF:{
+            compileExpr(compiler,stmt->as.ifStmt.condition);
+            int thenJump = emitJump(compiler,OP_JUMP_IF_FALSE,compiler->token);
+            compileStmt(compiler,stmt->as.ifStmt.thenBranch);
+            if(stmt->as.ifStmt.elseBranch == NULL){
+                patchJump(compiler,thenJump);
+                break;
+            }
+            int endJump = emitJump(compiler,OP_JUMP,compiler->token);
+            patchJump(compiler,thenJump);
+            compileStmt(compiler,stmt->as.ifStmt.elseBranch);
+            patchJump(compiler,endJump);
+            break;
+        }
+        case STMT_WHILE:{
+            int start = compiler->chunk->count;
+            compileExpr(compiler,stmt->as.whileStmt.condition);
+            int exitJump = emitJump(compiler,OP_JUMP_IF_FALSE,compiler->token);
+            compileStmt(compiler,stmt->as.whileStmt.body);
+            emit(compiler,OP_JUMP,0,compiler->token);
+            emitOperand(compiler,start,compiler->token);
+            patchJump(compiler,exitJump);
+            break;
+        }
+        case STMT_BLOCK:
+            break;
+    }
+}
+
+//============ PUBLIC INTERFACE ==================
+
+bool compile(Chunk* chunk, Stmt** statements, int count){
+    Compiler compiler;
+    compiler.chunk = chunk;
+    compiler.depth = 0;
+    if(chunk->count > 0)compiler.token = chunk->tokens[chunk->count - 1];
+    else{
+        compiler.token.type = TOKEN_EOF;
+        compiler.token.start = "";
+        compiler.token.length = 0;
+        compiler.token.line = 1;
+    }
+    compiler.statements = statements;
+    compiler.count = count;
+    compiler.hadError = false;
+    for(int i = 0;i<count;i++){
+        compileStmt(&compiler,statements[i]);
+        if(compiler.hadError)break;
+    }
+    emit(&compiler,OP_RETURN,0,compiler.token);
+    return !compiler.hadError;
+}
@@ -0,0 +1,12 @@
+#ifndef COMPILER_HEADER_H
+#define COMPILER_HEADER_H
+#include "stdbool.h"
+#include "../Parsers/RecursiveDescentParser/AST.h"
+#include "chunk.h"
+
+// Lowers the statements to bytecode appended at the end of chunk,
+// followed by OP_RETURN. Variables already declared in the chunk keep
+// their slots. Returns false (after reporting) on a compile error.
+bool compile(Chunk* chunk, Stmt** statements, int count);
+
+#endif
@@ -0,0 +1,159 @@
+#include "stdlib.h"
+#include "string.h"
+#include "stdbool.h"
+#include "limits.h"
+#include "fusion.h"
+
+static bool isArithmetic(int op){
+    return op == OP_ADD || op == OP_SUB || op == OP_MUL || op == OP_DIV ||
+           op == OP_ADD_UNCHECKED || op == OP_SUB_UNCHECKED ||
+           op == OP_MUL_UNCHECKED || op == OP_DIV_UNCHECKED;
+}
+
+static bool isComparison(int op){
+    return op == OP_GREATER || op == OP_GREATER_EQUAL || op == OP_LESS ||
+           op == OP_LESS_EQUAL || op == OP_EQUAL || op == OP_NOT_EQUAL;
+}
+
+static bool isJump(int op){
+    return op == OP_JUMP || op == OP_JUMP_IF_FALSE ||
+           op == OP_CMP_JUMP_IF_FALSE || op == OP_CMP_CONST_JUMP_IF_FALSE;
+}
+
+// Offset of the target operand of a jump instruction.
+static int jumpOperand(int op){
+    return (op == OP_JUMP || op == OP_JUMP_IF_FALSE) ? 1 : 4;
+}
+
+typedef struct{
+    Chunk* chunk;
+    bool* isTarget;
+    int pcs[5];     // offsets of the instructions being matched
+    int ops[5];
+    int length;     // number of instructions available from pcs[0]
+}Window;
+
+// Collects up to five instructions starting at pc, stopping at a jump target.
+static void readWindow(Window* w, int pc){
+    Chunk* chunk = w->chunk;
+    w->length = 0;
+    while(w->length < 5 && pc < chunk->count){
+        if(w->length > 0 && w->isTarget[pc])break;
+        w->pcs[w->length] = pc;
+        w->ops[w->length] = chunk->code[pc];
+        w->length++;
+        pc += opcode_size(chunk->code[pc]);
+    }
+}
+
+static int operand(Window* w, int index, int offset){
+    return w->chunk->code[w->pcs[index] + offset];
+}
+
+// Writes the fused form of the sequence in w into out and returns the number
+// of instructions it replaces, or 0 when nothing matches.
+static int match(Window* w, int* out, int* outLength){
+    int* op = w->ops;
+    if(w->length >= 2 && op[0] == OP_LOAD && op[1] == OP_PRINT){
+        out[0] = OP_PRINT_LOCAL;
+        out[1] = operand(w,0,1);
+        *outLength = 2;
+        return 2;
+    }
+    if(w->length < 4 || op[0] != OP_LOAD || (op[1] != OP_LOAD && op[1] != OP_CONSTANT))return 0;
+    bool constant = op[1] == OP_CONSTANT;
+    int a = operand(w,0,1);
+    int b = operand(w,1,1);
+
+    if(isComparison(op[2]) && op[3] == OP_JUMP_IF_FALSE){
+        out[0] = constant ? OP_CMP_CONST_JUMP_IF_FALSE : OP_CMP_JUMP_IF_FALSE;
+        out[1] = op[2];
+        out[2] = a;
+        out[3] = b;
+        out[4] = operand(w,3,1);
+        *outLength = 5;
+        return 4;
+    }
+    if(w->length < 5 || !isArithmetic(op[2]) || op[3] != OP_STORE || op[4] != OP_POP)return 0;
+    int dest = operand(w,3,1);
+
+    bool add = op[2] == OP_ADD || op[2] == OP_ADD_UNCHECKED;
+    bool sub = op[2] == OP_SUB || op[2] == OP_SUB_UNCHECKED;
+    if(constant && dest == a && (add || (sub && b != INT_MIN))){
+        bool checked = op[2] == OP_ADD || op[2] == OP_SUB;
+        out[0] = checked ? OP_INC_LOCAL : OP_INC_LOCAL_UNCHECKED;
+        out[1] = a;
+        out[2] = add ? b : -b;
+        *outLength = 3;
+        return 5;
+    }
+    out[0] = constant ? OP_LOAD_CONST_OP_STORE : OP_LOAD_OP_STORE;
+    out[1] = op[2];
+    out[2] = a;
+    out[3] = b;
+    out[4] = dest;
+    *outLength = 5;
+    return 5;
+}
+
+void fuse(Chunk* chunk, int start){
+    int end = chunk->count;
+    bool* isTarget = calloc(end + 1,sizeof(bool));
+    int* newOffset = malloc(sizeof(int) * (end + 1));
+    int* code = malloc(sizeof(int) * (end - start));
+    Token* tokens = malloc(sizeof(Token) * (end - start));
+
+    for(int pc = start;pc<end;pc += opcode_size(chunk->code[pc])){
+        int op = chunk->code[pc];
+        if(isJump(op))isTarget[chunk->code[pc + jumpOperand(op)]] = true;
+    }
+
+    Window w;
+    w.chunk = chunk;
+    w.isTarget = isTarget;
+    int count = 0;
+    int pc = start;
+    while(pc < end){
+        readWindow(&w,pc);
+        int fused[5];
+        int fusedLength = 0;
+        int replaced = match(&w,fused,&fusedLength);
+        newOffset[pc] = start + count;
+        if(replaced > 0){
+            // A fused instruction fails where its operator would have, so it
+            // takes the operator's token (the third instruction) when it has one.
+            Token token = chunk->tokens[replaced >= 3 ? w.pcs[2] : pc];
+            for(int i = 0;i<fusedLength;i++){
+                code[count] = fused[i];
+                tokens[count] = token;
+                count++;
+            }
+            int last = w.pcs[replaced - 1];
+            pc = last + opcode_size(chunk->code[last]);
+        }else{
+            int size = opcode_size(chunk->code[pc]);
+            for(int i = 0;i<size;i++){
+                code[count] = chunk->code[pc + i];
+                tokens[count] = chunk->tokens[pc + i];
+                count++;
+            }
+            pc += size;
+        }
+    }
+    newOffset[end] = start + count;
+
+    // Targets always start an instruction, so newOffset is defined for them.
+    for(int i = 0;i<count;i += opcode_size(code[i])){
+        if(!isJump(code[i]))continue;
+        int* target = &code[i + jumpOperand(code[i])];
+        if(*target >= start)*target = newOffset[*target];
+    }
+    memcpy(chunk->code + start,code,sizeof(int) * count);
+    memcpy(chunk->tokens + start,tokens,sizeof(Token) * count);
+    chunk->count = start + count;
+
+    free(isTarget);
+    free(newOffset);
+    free(code);
+    free(tokens);
+}
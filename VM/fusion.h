@@ -0,0 +1,19 @@
+#ifndef FUSION_HEADER_H
+#define FUSION_HEADER_H
+#include "chunk.h"
+
+// Peephole pass that rewrites the hottest instruction sequences of the
+// code from `start` to the end of the chunk into superinstructions:
+//
+//   x = x + K;        LOAD CONSTANT ADD STORE POP   -> INC_LOCAL
+//   x = a op b;       LOAD LOAD op STORE POP        -> LOAD_OP_STORE
+//   x = a op K;       LOAD CONSTANT op STORE POP    -> LOAD_CONST_OP_STORE
+//   while (a < K)     LOAD CONSTANT cmp JUMP_IF_FALSE -> CMP_CONST_JUMP_IF_FALSE
+//   while (a < b)     LOAD LOAD cmp JUMP_IF_FALSE   -> CMP_JUMP_IF_FALSE
+//   print a;          LOAD PRINT                    -> PRINT_LOCAL
+//
+// A sequence is left alone when a jump lands inside it. Jump targets are
+// remapped to the shortened code.
+void fuse(Chunk* chunk, int start);
+
+#endif
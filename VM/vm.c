@@ -0,0 +1,304 @@
+#include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "limits.h"
+#include "vm.h"
+
+//============ HELPER FUNCTIONS ==================
+
+// Same format as the tree walking interpreter.
+static void runtimeError(VM* vm, int pc, const char* message){
+    vm->hadError = true;
+    vm->errorPc = pc;
+    Token* token = &vm->chunk->tokens[pc];
+    fprintf(stderr, "[line %d] Runtime error at '%.*s': %s\n", token->line, token->length, token->start, message);
+}
+
+// Applies an arithmetic opcode with overflow and division checks.
+static inline bool arithmetic(VM* vm, int op, int a, int b, int* result, int pc){
+    switch(op){
+        case OP_ADD:
+            if(__builtin_add_overflow(a,b,result))break;
+            return true;
+        case OP_SUB:
+            if(__builtin_sub_overflow(a,b,result))break;
+            return true;
+        case OP_MUL:
+            if(__builtin_mul_overflow(a,b,result))break;
+            return true;
+        case OP_DIV:
+            if(b == 0){
+                runtimeError(vm,pc,"Division by zero.");
+                return false;
+            }
+            if(a == INT_MIN && b == -1)break;
+            *result = a / b;
+            return true;
+        case OP_ADD_UNCHECKED: *result = a + b; return true;
+        case OP_SUB_UNCHECKED: *result = a - b; return true;
+        case OP_MUL_UNCHECKED: *result = a * b; return true;
+        case OP_DIV_UNCHECKED: *result = a / b; return true;
+    }
+    runtimeError(vm,pc,"Integer overflow.");
+    return false;
+}
+
+static inline int comparison(int op, int a, int b){
+    switch(op){
+        case OP_GREATER:       return a > b;
+        case OP_GREATER_EQUAL: return a >= b;
+        case OP_LESS:          return a < b;
+        case OP_LESS_EQUAL:    return a <= b;
+        case OP_EQUAL:         return a == b;
+        default:               return a != b;
+    }
+}
+
+// Makes room for slots and stack the chunk has grown since the last run.
+void vm_reserve(VM* vm){
+    Chunk* chunk = vm->chunk;
+    if(chunk->slotCount > vm->slotCapacity){
+        vm->slots = realloc(vm->slots, sizeof(int) * chunk->slotCount);
+        memset(vm->slots + vm->slotCapacity, 0, sizeof(int) * (chunk->slotCount - vm->slotCapacity));
+        vm->slotCapacity = chunk->slotCount;
+    }
+    if(chunk->maxStack > vm->stackCapacity){
+        vm->stack = realloc(vm->stack, sizeof(int) * chunk->maxStack);
+        vm->stackCapacity = chunk->maxStack;
+    }
+}
+
+//============ DISPATCH LOOP =====================
+
+// Inlined once per mode, so the plain loop carries no profiling code.
+static inline __attribute__((always_inline)) bool execute(VM* vm, int start, const bool profile, const bool count, const bool publish){
+    const int* code = vm->chunk->code;
+    long long* pcCounts = vm->pcCounts;
+    int* slots = vm->slots;
+    int* stack = vm->stack;
+    int* top = stack;
+    int pc = start;
+    int previous = -1;
+
+    for(;;){
+        int op = code[pc];
+        if(profile){
+            vm->opCounts[op]++;
+            if(previous >= 0)vm->pairCounts[previous][op]++;
+            previous = op;
+        }
+        if(count)pcCounts[pc]++;
+        if(publish)vm->currentPc = pc;
+        switch(op){
+            case OP_CONSTANT:
+                *top++ = code[pc + 1];
+                pc += 2;
+                break;
+            case OP_LOAD:
+                *top++ = slots[code[pc + 1]];
+                pc += 2;
+                break;
+            case OP_STORE:
+                slots[code[pc + 1]] = top[-1];
+                pc += 2;
+                break;
+            case OP_POP:
+                top--;
+                pc++;
+                break;
+            case OP_ADD:
+            case OP_SUB:
+            case OP_MUL:
+            case OP_DIV:
+                if(!arithmetic(vm,op,top[-2],top[-1],&top[-2],pc))return false;
+                top--;
+                pc++;
+                break;
+            case OP_NEGATE:
+                if(top[-1] == INT_MIN){
+                    runtimeError(vm,pc,"Integer overflow.");
+                    return false;
+                }
+                top[-1] = -top[-1];
+                pc++;
+                break;
+            case OP_NOT:
+                top[-1] = !top[-1];
+                pc++;
+                break;
+            case OP_ADD_UNCHECKED:
+                top[-2] += top[-1];
+                top--;
+                pc++;
+                break;
+            case OP_SUB_UNCHECKED:
+                top[-2] -= top[-1];
+                top--;
+                pc++;
+                break;
+            case OP_MUL_UNCHECKED:
+                top[-2] *= top[-1];
+                top--;
+                pc++;
+                break;
+            case OP_DIV_UNCHECKED:
+                top[-2] /= top[-1];
+                top--;
+                pc++;
+                break;
+            case OP_NEGATE_UNCHECKED:
+                top[-1] = -top[-1];
+                pc++;
+                break;
+            case OP_GREATER:
+            case OP_GREATER_EQUAL:
+            case OP_LESS:
+            case OP_LESS_EQUAL:
+            case OP_EQUAL:
+            case OP_NOT_EQUAL:
+                top[-2] = comparison(op,top[-2],top[-1]);
+                top--;
+                pc++;
+                break;
+            case OP_PRINT:
+                output_int_line(vm->out,*--top);
+                pc++;
+                break;
+            case OP_JUMP:
+                pc = code[pc + 1];
+                break;
+            case OP_JUMP_IF_FALSE:
+                pc = *--top ? pc + 2 : code[pc + 1];
+                break;
+            case OP_RETURN:
+                return true;
+            case OP_UNDEFINED:
+                runtimeError(vm,pc,"Undefined variable.");
+                return false;
+
+            // The fused stores only happen once the operation succeeded, like
+            // the STORE that follows the plain arithmetic opcodes.
+            case OP_INC_LOCAL:{
+                int result;
+                if(__builtin_add_overflow(slots[code[pc + 1]],code[pc + 2],&result)){
+                    runtimeError(vm,pc,"Integer overflow.");
+                    return false;
+                }
+                slots[code[pc + 1]] = result;
+                pc += 3;
+                break;
+            }
+            case OP_INC_LOCAL_UNCHECKED:
+                slots[code[pc + 1]] += code[pc + 2];
+                pc += 3;
+                break;
+            case OP_LOAD_OP_STORE:{
+                int result;
+                if(!arithmetic(vm,code[pc + 1],slots[code[pc + 2]],slots[code[pc + 3]],&result,pc))return false;
+                slots[code[pc + 4]] = result;
+                pc += 5;
+                break;
+            }
+            case OP_LOAD_CONST_OP_STORE:{
+                int result;
+                if(!arithmetic(vm,code[pc + 1],slots[code[pc + 2]],code[pc + 3],&result,pc))return false;
+                slots[code[pc + 4]] = result;
+                pc += 5;
+                break;
+            }
+            case OP_CMP_JUMP_IF_FALSE:
+                pc = comparison(code[pc + 1],slots[code[pc + 2]],slots[code[pc + 3]]) ? pc + 5 : code[pc + 4];
+                break;
+            case OP_CMP_CONST_JUMP_IF_FALSE:
+                pc = comparison(code[pc + 1],slots[code[pc + 2]],code[pc + 3]) ? pc + 5 : code[pc + 4];
+                break;
+            case OP_PRINT_LOCAL:
+                output_int_line(vm->out,slots[code[pc + 1]]);
+                pc += 2;
+                break;
+            default:
+                runtimeError(vm,pc,"Unknown opcode.");
+                return false;
+        }
+    }
+}
+
+//============ PUBLIC INTERFACE ==================
+
+void vm_init(VM* vm, Chunk* chunk, Output* out){
+    vm->chunk = chunk;
+    vm->slots = NULL;
+    vm->slotCapacity = 0;
+    vm->stack = NULL;
+    vm->stackCapacity = 0;
+    vm->out = out;
+    vm->hadError = false;
+    vm->errorPc = -1;
+    vm->profile = false;
+    vm->pcCounts = NULL;
+    vm->publishPc = false;
+    vm->currentPc = -1;
+    memset(vm->opCounts, 0, sizeof(vm->opCounts));
+    memset(vm->pairCounts, 0, sizeof(vm->pairCounts));
+}
+
+bool vm_run(VM* vm, int start){
+    vm_reserve(vm);
+    vm->hadError = false;
+    bool ok;
+    if(vm->profile)ok = execute(vm,start,true,vm->pcCounts != NULL,false);
+    else if(vm->pcCounts != NULL)ok = execute(vm,start,false,true,false);
+    else if(vm->publishPc)ok = execute(vm,start,false,false,true);
+    else ok = execute(vm,start,false,false,false);
+    vm->currentPc = -1;
+    output_flush(vm->out);
+    return ok;
+}
+
+typedef struct{
+    int first;
+    int second;
+    long long count;
+}Pair;
+
+static int comparePairs(const void* a, const void* b){
+    long long x = ((const Pair*)a)->count;
+    long long y = ((const Pair*)b)->count;
+    return (x < y) - (x > y);
+}
+
+void vm_report_profile(VM* vm, FILE* file, int top){
+    Pair pairs[OP_COUNT * OP_COUNT];
+    int count = 0;
+    long long total = 0;
+    for(int i = 0;i<OP_COUNT;i++){
+        total += vm->opCounts[i];
+        for(int j = 0;j<OP_COUNT;j++){
+            if(vm->pairCounts[i][j] == 0)continue;
+            pairs[count].first = i;
+            pairs[count].second = j;
+            pairs[count].count = vm->pairCounts[i][j];
+            count++;
+        }
+    }
+    qsort(pairs, count, sizeof(Pair), comparePairs);
+
+    fprintf(file, "--- Instruction profile (%lld dispatches) ---\n", total);
+    for(int i = 0;i<OP_COUNT;i++){
+        if(vm->opCounts[i] == 0)continue;
+        fprintf(file, "%-26s %12lld  %5.1f%%\n", opcode_name(i), vm->opCounts[i], 100.0 * vm->opCounts[i] / total);
+    }
+    fprintf(file, "--- Hottest pairs ---\n");
+    for(int i = 0;i<count && i<top;i++){
+        char name[64];
+        snprintf(name, sizeof(name), "%s -> %s", opcode_name(pairs[i].first), opcode_name(pairs[i].second));
+        fprintf(file, "%-52s %12lld  %5.1f%%\n", name, pairs[i].count, 100.0 * pairs[i].count / total);
+    }
+    fprintf(file, "--------------------------\n");
+}
+
+void vm_free(VM* vm){
+    free(vm->slots);
+    free(vm->stack);
+    vm_init(vm,vm->chunk,vm->out);
+}
@@ -0,0 +1,47 @@
+#ifndef VM_HEADER_H
+#define VM_HEADER_H
+#include "stdio.h"
+#include "stdbool.h"
+#include "chunk.h"
+#include "../Interpreter/output.h"
+
+typedef struct{
+    Chunk* chunk;
+    int* slots;
+    int slotCapacity;
+    int* stack;
+    int stackCapacity;
+    Output* out;
+    bool hadError;
+    int errorPc;        // instruction that raised the last runtime error
+
+    // Profile mode: how often each instruction and each pair of
+    // consecutive instructions ran. Used to pick what fuse() covers.
+    bool profile;
+    long long opCounts[OP_COUNT];
+    long long pairCounts[OP_COUNT][OP_COUNT];
+
+    // Line profile, set up by profiler_attach_vm. With pcCounts every
+    // instruction adds one to pcCounts[pc]; with publishPc the running pc
+    // is kept in currentPc for the sampling timer to read.
+    long long* pcCounts;
+    bool publishPc;
+    volatile int currentPc;     // -1 outside vm_run
+}VM;
+
+void vm_init(VM* vm, Chunk* chunk, Output* out);
+
+// Sizes the slots and the stack for the chunk. vm_run does this too, call
+// it up front so that runs never allocate.
+void vm_reserve(VM* vm);
+
+// Runs the chunk from code offset `start` until OP_RETURN. Slots keep
+// their values between runs. Returns false on a runtime error.
+bool vm_run(VM* vm, int start);
+
+// Prints the `top` most executed instruction pairs (profile mode only).
+void vm_report_profile(VM* vm, FILE* file, int top);
+
+void vm_free(VM* vm);
+
+#endif
@@ -1,10 +1,248 @@
 #include "stdio.h"
+#include "stdlib.h"
+#include "string.h"
+#include "time.h"
 #include "./Lexer/lexer.h"
 #include "./Parsers/RecursiveDescentParser/RDparser.h"
 #include "./Parsers/RecursiveDescentParser/AST.h"
-Lexer lexer;
-Parser parser;
-int main(){
+#include "./Parsers/LL1Parser/LL1parser.h"
+#include "./Interpreter/interpreter.h"
+#include "./Interpreter/batch.h"
+#include "./VM/compiler.h"
+#include "./VM/fusion.h"
+#include "./VM/vm.h"
+#include "./Analysis/range.h"
+#include "./Repl/repl.h"
+#include "./Profiler/profiler.h"
+static char* readFile(const char* path){
+    FILE* file = fopen(path, "rb");
+    if(file == NULL){
+        fprintf(stderr, "Could not open file \"%s\".\n", path);
+        exit(74);
+    }
+    fseek(file, 0L, SEEK_END);
+    long size = ftell(file);
+    rewind(file);
+    char* buffer = (char*)malloc(size + 1);
+    size_t read = fread(buffer, 1, size, file);
+    buffer[read] = '\0';
+    fclose(file);
+    return buffer;
+}
+
+// Parses the source repeatedly with both parsers and reports the time per parse.
+static void benchParsers(const char* source){
+    int runs = 20000000 / (int)(strlen(source) + 1);
+    if(runs < 10)runs = 10;
+    int cnt = 0;
+    clock_t start = clock();
+    for(int i = 0;i<runs;i++)freeAst(parse(source,&cnt),cnt);
+    double rd = (double)(clock() - start) / CLOCKS_PER_SEC;
+    start = clock();
+    for(int i = 0;i<runs;i++)freeAst(ll1_parse(source,&cnt),cnt);
+    double table = (double)(clock() - start) / CLOCKS_PER_SEC;
+    fprintf(stderr, "recursive descent: %.2fus per parse\n", rd * 1e6 / runs);
+    fprintf(stderr, "LL(1) table:       %.2fus per parse\n", table * 1e6 / runs);
+}
+
+//============ BATCH MODE ========================
+
+// Input frames for --batch. The first non-empty line of the file names the
+// variables, every further non-empty line is one frame holding a value for
+// each.
+typedef struct{
+    const char** names;
+    int nameCount;
+    int* values;    // frame i at values[i * nameCount]
+    int lanes;
+}Frames;
+
+// Splits the file in place; the names point into `text`.
+static bool parseFrames(char* text, Frames* frames){
+    frames->names = NULL;
+    frames->nameCount = 0;
+    frames->values = NULL;
+    frames->lanes = 0;
+    int capacity = 0;
+    int line = 0;
+    char* next = text;
+    while(next != NULL && *next != '\0'){
+        char* start = next;
+        next = strchr(start,'\n');
+        if(next != NULL)*next++ = '\0';
+        line++;
+        bool naming = frames->nameCount == 0;
+        int found = 0;
+        for(char* word = strtok(start," \t\r");word != NULL;word = strtok(NULL," \t\r")){
+            if(naming){
+                for(int j = 0;j<frames->nameCount;j++){
+                    if(strcmp(frames->names[j],word) != 0)continue;
+                    fprintf(stderr, "[line %d] Error in frames: '%s' is named twice.\n", line, word);
+                    return false;
+                }
+                frames->names = realloc(frames->names,sizeof(char*) * (frames->nameCount + 1));
+                frames->names[frames->nameCount++] = word;
+                continue;
+            }
+            char* end;
+            long value = strtol(word,&end,10);
+            if(*end != '\0' || found >= frames->nameCount){
+                fprintf(stderr, "[line %d] Error in frames: expect %d integers.\n", line, frames->nameCount);
+                return false;
+            }
+            if(found == 0){
+                if(frames->lanes >= capacity){
+                    capacity = capacity < 8 ? 8 : capacity * 2;
+                    frames->values = realloc(frames->values,sizeof(int) * capacity * frames->nameCount);
+                }
+                frames->lanes++;
+            }
+            frames->values[(frames->lanes - 1) * frames->nameCount + found++] = (int)value;
+        }
+        if(!naming && found != 0 && found != frames->nameCount){
+            fprintf(stderr, "[line %d] Error in frames: expect %d integers.\n", line, frames->nameCount);
+            return false;
+        }
+    }
+    if(frames->nameCount == 0 || frames->lanes == 0){
+        fprintf(stderr, "Frames need a line of names and at least one frame.\n");
+        return false;
+    }
+    return true;
+}
+
+// Checks what a verification run prints against a lane's output as it is
+// flushed, without collecting it.
+typedef struct{
+    const char* expected;
+    int length;
+    int position;
+    bool same;
+}Comparison;
+
+static void compareOutput(void* user, const char* data, int length){
+    Comparison* comparison = (Comparison*)user;
+    if(comparison->position + length > comparison->length ||
+       memcmp(comparison->expected + comparison->position,data,length) != 0){
+        comparison->same = false;
+        return;
+    }
+    comparison->position += length;
+}
+
+// Runs every frame through run_batch and prints each lane's final values
+// and output. With verify, every frame is also run on its own through
+// interpret() and must print the same and fail the same way.
+static int runBatch(Stmt** stmt, int cnt, Frames* frames, bool verify){
+    int lanes = frames->lanes, nameCount = frames->nameCount;
+    BatchOutput prints;
+    batch_output_init(&prints);
+    bool* failed = malloc(sizeof(bool) * lanes);
+    int* finals = malloc(sizeof(int) * lanes * nameCount);
+    memcpy(finals,frames->values,sizeof(int) * lanes * nameCount);
+    int completed = run_batch(stmt,cnt,frames->names,nameCount,finals,lanes,&prints,failed);
+
+    Output out;
+    output_init_fd(&out,1);
+    char header[64];
+    for(int i = 0;i<lanes;i++){
+        output_write(&out,header,snprintf(header,sizeof(header),"frame %d%s:",i,failed[i] ? " (failed)" : ""));
+        for(int j = 0;j<nameCount;j++){
+            output_write(&out,header,snprintf(header,sizeof(header)," %s=%d",frames->names[j],finals[i * nameCount + j]));
+        }
+        output_write(&out,"\n",1);
+        batch_output_write(&prints,i,&out);
+    }
+    output_free(&out);
+
+    int mismatches = 0;
+    Output expected;
+    output_init_memory(&expected);
+    for(int i = 0;verify && i<lanes;i++){
+        output_memory_reset(&expected);
+        batch_output_write(&prints,i,&expected);
+        Comparison comparison;
+        comparison.expected = output_memory_data(&expected,&comparison.length);
+        comparison.position = 0;
+        comparison.same = true;
+        Output single;
+        output_init_callback(&single,compareOutput,&comparison);
+        Interpreter interp;
+        interpreter_init(&interp,&single);
+        for(int j = 0;j<nameCount;j++){
+            Token name;
+            name.type = TOKEN_IDENTIFIER;
+            name.start = frames->names[j];
+            name.length = (int)strlen(frames->names[j]);
+            name.line = 0;
+            interpreter_define(&interp,name,frames->values[i * nameCount + j]);
+        }
+        bool ok = interpret(&interp,stmt,cnt);
+        if(ok == failed[i] || !comparison.same || comparison.position != comparison.length){
+            fprintf(stderr, "frame %d: batch run differs from interpret().\n", i);
+            mismatches++;
+        }
+        interpreter_free(&interp);
+        output_free(&single);
+    }
+    if(verify)fprintf(stderr, "verified %d frames, %d mismatches\n", lanes, mismatches);
+
+    output_free(&expected);
+    batch_output_free(&prints);
+    free(failed);
+    free(finals);
+    return (mismatches > 0 || completed < lanes) ? 70 : 0;
+}
+
+// Hot spots and the annotated source to stderr, folded stacks to a file.
+static void writeProfile(Profiler* profiler, const char* source, const char* foldedPath){
+    profiler_write_hotspots(profiler,stderr,10);
+    fprintf(stderr, "\n");
+    profiler_write_listing(profiler,source,stderr);
+    if(foldedPath == NULL)return;
+    FILE* folded = fopen(foldedPath, "w");
+    if(folded == NULL){
+        fprintf(stderr, "Could not write \"%s\".\n", foldedPath);
+        return;
+    }
+    profiler_write_folded(profiler,folded);
+    fclose(folded);
+}
+
+// Usage: main --repl
+//        main --bench-parse [file]
+//        main [--ll1] [--ast] [--tree] [--dump] [--no-fuse] [--profile] [--checked] [file]
+//        main [--trace | --sample] [--folded out.folded] [--tree] [file]
+//        main --batch frames.txt [--verify] [file]
+int main(int argc, char** argv){
+    bool showAst = false, useTree = false, dump = false, fusion = true, profile = false, ranges = true;
+    bool useTable = false, benchParse = false, trace = false;
+    ProfileMode traceMode = PROFILE_EXACT;
+    const char* foldedPath = NULL;
+    const char* framesPath = NULL;
+    bool verify = false;
+    const char* path = NULL;
+    for(int i = 1;i<argc;i++){
+        if(strcmp(argv[i], "--ast") == 0)showAst = true;
+        else if(strcmp(argv[i], "--tree") == 0)useTree = true;
+        else if(strcmp(argv[i], "--dump") == 0)dump = true;
+        else if(strcmp(argv[i], "--no-fuse") == 0)fusion = false;
+        else if(strcmp(argv[i], "--profile") == 0)profile = true;
+        else if(strcmp(argv[i], "--checked") == 0)ranges = false;
+        else if(strcmp(argv[i], "--repl") == 0)return repl();
+        else if(strcmp(argv[i], "--ll1") == 0)useTable = true;
+        else if(strcmp(argv[i], "--bench-parse") == 0)benchParse = true;
+        else if(strcmp(argv[i], "--trace") == 0)trace = true;
+        else if(strcmp(argv[i], "--sample") == 0){
+            trace = true;
+            traceMode = PROFILE_SAMPLE;
+        }
+        else if(strcmp(argv[i], "--folded") == 0 && i + 1 < argc)foldedPath = argv[++i];
+        else if(strcmp(argv[i], "--batch") == 0 && i + 1 < argc)framesPath = argv[++i];
+        else if(strcmp(argv[i], "--verify") == 0)verify = true;
+        else path = argv[i];
+    }
+
     const char* source =
         "    //hey i am ankit\n"
         "    "
@@ -36,9 +274,72 @@ int main(){
     //         break;
     //     }
     // }
+    if(path != NULL)source = readFile(path);
+
+    if(benchParse){
+        benchParsers(source);
+        return 0;
+    }
+
     int cnt = 0;
-    Stmt** stmt = parse(source,&cnt);
-    printAst(stmt,cnt);
+    Stmt** stmt = useTable ? ll1_parse(source,&cnt) : parse(source,&cnt);
+    if(showAst)printAst(stmt,cnt);
+    if(useTable ? ll1.hadError : parser.hadError)return 65;
+    if(ranges){
+        RangeStats stats = analyze_ranges(stmt,cnt);
+        if(dump)fprintf(stderr, "range analysis: %d of %d checks removed\n", stats.proven, stats.operations);
+    }
+
+    // The AST dump goes through stdio, the program output does not.
+    fflush(stdout);
+    if(framesPath != NULL){
+        Frames frames;
+        if(!parseFrames(readFile(framesPath),&frames))return 65;
+        int status = runBatch(stmt,cnt,&frames,verify);
+        free(frames.names);
+        free(frames.values);
+        return status;
+    }
+    Output out;
+    output_init_fd(&out,1);
+    Profiler profiler;
+    if(trace)profiler_init(&profiler,traceMode,stmt,cnt);
+    bool ok;
+    if(useTree){
+        Interpreter interp;
+        interpreter_init(&interp,&out);
+        if(trace){
+            interp.profiler = &profiler;
+            profiler_start(&profiler);
+        }
+        ok = interpret(&interp,stmt,cnt);
+        if(trace)profiler_stop(&profiler);
+        interpreter_free(&interp);
+    }else{
+        Chunk chunk;
+        chunk_init(&chunk);
+        if(!compile(&chunk,stmt,cnt))return 65;
+        if(fusion)fuse(&chunk,0);
+        if(dump)disassemble_chunk(&chunk,stderr);
+        VM vm;
+        vm_init(&vm,&chunk,&out);
+        vm.profile = profile;
+        if(trace){
+            profiler_attach_vm(&profiler,&vm);
+            profiler_start(&profiler);
+        }
+        ok = vm_run(&vm,0);
+        if(trace)profiler_stop(&profiler);
+        if(profile)vm_report_profile(&vm,stderr,10);
+        vm_free(&vm);
+        chunk_free(&chunk);
+    }
+    if(trace){
+        writeProfile(&profiler,source,foldedPath);
+        profiler_free(&profiler);
+    }
+    output_free(&out);
+    if(!ok)return 70;
 
     return 0;
 }
\ No newline at end of file